@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+#include "map/concurrent_hash_map.h"
+
+/*
+ * throughput of concurrent_hash_map from 1 to 64 threads for several read ratios,
+ * with 64 shards and with a single shard, i.e. one lock around the whole table.
+ * usage: bench_concurrent_hash_map_scaling [operations per thread, default 1M]
+ */
+using map_t = data_structures_cpp::concurrent_hash_map<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>>;
+using clock_t_ = std::chrono::steady_clock;
+
+std::uint64_t const key_range = 1 << 20;
+
+double run(map_t& map, int threads, int read_percent, std::size_t operations)
+{
+	std::atomic<std::uint64_t> checksum{ 0 };
+	std::vector<std::thread> workers{};
+	auto start = clock_t_::now();
+	for (int t = 0; t < threads; ++t)
+	{
+		workers.emplace_back([&, t]() {
+			std::mt19937_64 generator(t);
+			std::uint64_t sum = 0;
+			for (std::size_t i = 0; i < operations; ++i)
+			{
+				std::uint64_t r = generator();
+				std::uint64_t k = r % key_range;
+				if (static_cast<int>((r >> 32) % 100) < read_percent)
+				{
+					auto v = map.find(k);
+					sum += v ? *v : 0;
+				}
+				else if ((r >> 40) & 1) map.put(k, r);
+				else map.erase(k);
+			}
+			checksum += sum;
+		});
+	}
+	for (auto& w : workers) w.join();
+	double seconds = std::chrono::duration<double>(clock_t_::now() - start).count();
+	if (checksum == 1) std::printf(" ");
+	return threads * operations / seconds;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t operations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::printf("%u hardware threads, %zu operations per thread, million operations/s\n",
+		std::thread::hardware_concurrency(), operations);
+	std::printf("%8s %6s %12s %12s\n", "reads", "threads", "64 shards", "1 shard");
+	for (int read_percent : { 50, 90, 99 })
+	{
+		for (int threads = 1; threads <= 64; threads *= 2)
+		{
+			map_t sharded{ 64 }, global{ 1 };
+			for (std::uint64_t k = 0; k < key_range; k += 2)
+			{
+				sharded.put(k, k);
+				global.put(k, k);
+			}
+			double s = run(sharded, threads, read_percent, operations);
+			double g = run(global, threads, read_percent, operations);
+			std::printf("%7d%% %6d %12.2f %12.2f\n", read_percent, threads, s / 1e6, g / 1e6);
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+
+#include "map/dictionary.h"
+#include "map/contiguous_dictionary.h"
+
+/*
+ * time to visit every value of every key through find_all, for keys holding
+ * many values, in dictionary (one list node per value) and contiguous_dictionary.
+ * usage: bench_dictionary_find_all [values per key, default 1000]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+int main(int argc, char** argv)
+{
+	int const keys = 1000;
+	int values = argc > 1 ? std::atoi(argv[1]) : 1000;
+	data_structures_cpp::dictionary<int, std::uint64_t, std::hash<int>> linked{ keys };
+	data_structures_cpp::contiguous_dictionary<int, std::uint64_t, std::hash<int>> contiguous{ keys };
+	for (int v = 0; v < values; ++v)
+	{
+		for (int k = 0; k < keys; ++k)
+		{
+			linked.insert(k, v);
+			contiguous.insert(k, v);
+		}
+	}
+
+	std::uint64_t checksum = 0;
+	auto start = clock_t_::now();
+	for (int k = 0; k < keys; ++k)
+	{
+		auto range = linked.find_all(k);
+		for (auto it = range.begin(); it != range.end(); ++it) checksum += it->value();
+	}
+	double linked_ns = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count();
+
+	start = clock_t_::now();
+	for (int k = 0; k < keys; ++k)
+	{
+		for (std::uint64_t v : contiguous.find_all(k)) checksum += v;
+	}
+	double contiguous_ns = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count();
+
+	double total = static_cast<double>(keys) * values;
+	std::printf("%d keys with %d values each, ns per value visited\n", keys, values);
+	std::printf("%-22s %10.2f\n", "dictionary", linked_ns / total);
+	std::printf("%-22s %10.2f\n", "contiguous_dictionary", contiguous_ns / total);
+	std::printf("(checksum %llu)\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
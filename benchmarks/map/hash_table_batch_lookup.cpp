@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "map/separate_chaining_hash_table.h"
+
+/*
+ * lookups per second of separate_chaining_hash_table::find_batch by batch size,
+ * against one find per key, on a table too large for the caches.
+ * usage: bench_hash_table_batch_lookup [entries, default 10M]
+ */
+using key_t_ = std::uint64_t;
+using table_t = data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_, std::hash<key_t_>>;
+using clock_t_ = std::chrono::steady_clock;
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::size_t const lookups = 1 << 22;
+	std::mt19937_64 generator{ 42 };
+
+	std::vector<key_t_> keys(entries);
+	for (auto& k : keys) k = generator();
+	table_t table{};
+	for (key_t_ k : keys) table.put(k, k);
+
+	std::vector<key_t_> probes(lookups);
+	std::uniform_int_distribution<std::size_t> index(0, entries - 1);
+	for (auto& k : probes) k = keys[index(generator)];
+
+	std::uint64_t checksum = 0;
+	auto start = clock_t_::now();
+	for (key_t_ k : probes) checksum += (*table.find(k)).value();
+	double single = lookups / std::chrono::duration<double>(clock_t_::now() - start).count();
+
+	std::printf("%zu entries, %zu lookups\n", entries, lookups);
+	std::printf("%-10s %16s\n", "batch", "lookups/s");
+	std::printf("%-10s %16.3e\n", "find", single);
+	for (std::size_t batch_size : { 1, 4, 16, 64, 256, 1024, 4096 })
+	{
+		std::vector<key_t_> batch(batch_size);
+		std::vector<table_t::iterator> out{};
+		start = clock_t_::now();
+		for (std::size_t i = 0; i + batch_size <= lookups; i += batch_size)
+		{
+			batch.assign(probes.begin() + i, probes.begin() + i + batch_size);
+			table.find_batch(batch, out);
+			for (auto const& it : out) checksum += (*it).value();
+		}
+		double rate = (lookups / batch_size * batch_size) / std::chrono::duration<double>(clock_t_::now() - start).count();
+		std::printf("%-10zu %16.3e\n", batch_size, rate);
+	}
+	std::printf("(checksum %llu)\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "map/separate_chaining_hash_table.h"
+#include "map/dictionary.h"
+
+/*
+ * lookups of absent keys in separate_chaining_hash_table and dictionary, with and without
+ * a blocked_bloom_filter front, for integer and string keys and several load factors.
+ * usage: bench_hash_table_filtered_misses [entries, default 1M]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+template <class Table, class Key>
+double misses_per_second(Table& table, std::vector<Key> const& misses)
+{
+	std::size_t found = 0;
+	auto start = clock_t_::now();
+	for (auto const& k : misses) found += table.contains(k);
+	double seconds = std::chrono::duration<double>(clock_t_::now() - start).count();
+	if (found != 0) std::printf("unexpected hits: %zu\n", found);
+	return misses.size() / seconds / 1e6;
+}
+
+template <class Table, class Key>
+void measure(char const* name, std::vector<Key> const& keys, std::vector<Key> const& misses, float load_factor)
+{
+	Table table;
+	table.max_load_factor(load_factor);
+	for (std::size_t i = 0; i < keys.size(); ++i) table.insert_or_put(keys[i], i);
+	double without = misses_per_second(table, misses);
+	std::printf("  %-34s %5.1f %14.1f", name, load_factor, without);
+	for (double rate : { 0.01, 0.001 })
+	{
+		table.enable_filter(rate);
+		std::printf(" %14.1f", misses_per_second(table, misses));
+	}
+	std::printf("\n");
+}
+
+// put and find for maps, insert and find_all for dictionaries
+template <class K>
+struct map_t : data_structures_cpp::separate_chaining_hash_table<K, std::size_t>
+{
+	void insert_or_put(K const& k, std::size_t v) { this->put(k, v); }
+	bool contains(K const& k) { return this->find(k) != this->end(); }
+};
+
+template <class K>
+struct dictionary_t : data_structures_cpp::dictionary<K, std::size_t>
+{
+	void insert_or_put(K const& k, std::size_t v) { this->insert(k, v); }
+	bool contains(K const& k)
+	{
+		auto range = this->find_all(k);
+		return range.begin() != range.end();
+	}
+};
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::mt19937_64 generator{ 42 };
+	std::vector<std::uint64_t> keys(entries), misses(entries);
+	std::vector<std::string> string_keys(entries), string_misses(entries);
+	for (std::size_t i = 0; i < entries; ++i)
+	{
+		keys[i] = generator() | 1;
+		misses[i] = generator() & ~std::uint64_t(1);
+		string_keys[i] = "reference record " + std::to_string(keys[i]);
+		string_misses[i] = "reference record " + std::to_string(misses[i]);
+	}
+
+	std::printf("%zu entries, million absent key lookups per second\n  %-34s %5s %14s %14s %14s\n",
+		entries, "table", "load", "no filter", "filter 1%", "filter 0.1%");
+	for (float load_factor : { 1.0f, 4.0f })
+	{
+		measure<map_t<std::uint64_t>>("separate_chaining, uint64 keys", keys, misses, load_factor);
+		measure<map_t<std::string>>("separate_chaining, string keys", string_keys, string_misses, load_factor);
+		measure<dictionary_t<std::string>>("dictionary, string keys", string_keys, string_misses, load_factor);
+	}
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+
+#include "map/separate_chaining_hash_table.h"
+#include "map/swiss_hash_table.h"
+
+/*
+ * insertion, successful lookup and failed lookup times of swiss_hash_table against
+ * separate_chaining_hash_table (given n buckets up front) and std::unordered_map.
+ * usage: bench_hash_table_lookup [max entries, default 10M]
+ */
+using key_t_ = std::uint64_t;
+using clock_t_ = std::chrono::steady_clock;
+
+struct measurement
+{
+	double insert_ns{ 0 };
+	double hit_ns{ 0 };
+	double miss_ns{ 0 };
+	std::uint64_t checksum{ 0 };
+};
+
+template <class Table, class Put, class Find>
+measurement measure(Table& table, std::vector<key_t_> const& keys, std::vector<key_t_> const& misses, Put put, Find find)
+{
+	measurement m{};
+	auto start = clock_t_::now();
+	for (key_t_ k : keys) put(table, k);
+	auto inserted = clock_t_::now();
+	for (key_t_ k : keys) m.checksum += find(table, k);
+	auto hit = clock_t_::now();
+	for (key_t_ k : misses) m.checksum += find(table, k);
+	auto miss = clock_t_::now();
+	double n = static_cast<double>(keys.size());
+	m.insert_ns = std::chrono::duration<double, std::nano>(inserted - start).count() / n;
+	m.hit_ns = std::chrono::duration<double, std::nano>(hit - inserted).count() / n;
+	m.miss_ns = std::chrono::duration<double, std::nano>(miss - hit).count() / n;
+	return m;
+}
+
+void report(char const* name, std::size_t n, measurement const& m)
+{
+	std::printf("%-30s %12zu %12.1f %12.1f %12.1f   (%llu)\n", name, n, m.insert_ns, m.hit_ns, m.miss_ns,
+		static_cast<unsigned long long>(m.checksum));
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t max_entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::mt19937_64 generator{ 42 };
+
+	std::printf("%-30s %12s %12s %12s %12s   (ns per operation)\n", "table", "entries", "insert", "hit", "miss");
+	for (std::size_t n = 1000; n <= max_entries; n *= 10)
+	{
+		// odd keys are inserted, even keys are looked up to miss
+		std::vector<key_t_> keys(n), misses(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			keys[i] = generator() | 1;
+			misses[i] = generator() & ~key_t_(1);
+		}
+
+		{
+			data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_, std::hash<key_t_>> table(n);
+			report("separate_chaining_hash_table", n, measure(table, keys, misses,
+				[](auto& t, key_t_ k) { t.put(k, k); },
+				[](auto& t, key_t_ k) { auto it = t.find(k, k); return it == t.end() ? key_t_(0) : (*it).value(); }));
+		}
+		{
+			data_structures_cpp::swiss_hash_table<key_t_, key_t_, std::hash<key_t_>> table{};
+			report("swiss_hash_table", n, measure(table, keys, misses,
+				[](auto& t, key_t_ k) { t.put(k, k); },
+				[](auto& t, key_t_ k) { auto it = t.find(k); return it == t.end() ? key_t_(0) : it->value(); }));
+		}
+		{
+			std::unordered_map<key_t_, key_t_> table{};
+			report("std::unordered_map", n, measure(table, keys, misses,
+				[](auto& t, key_t_ k) { t[k] = k; },
+				[](auto& t, key_t_ k) { auto it = t.find(k); return it == t.end() ? key_t_(0) : it->second; }));
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,68 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "map/separate_chaining_hash_table.h"
+#include "map/swiss_hash_table.h"
+#include "map/robin_hood_hash_table.h"
+
+/*
+ * lookup time as a function of the fraction of lookups for absent keys,
+ * for tables holding the same entries.
+ * usage: bench_hash_table_miss_ratio [entries, default 1M]
+ */
+using key_t_ = std::uint64_t;
+using clock_t_ = std::chrono::steady_clock;
+
+template <class Table, class Find>
+double lookup_ns(Table& table, std::vector<key_t_> const& lookups, Find find, std::uint64_t& checksum)
+{
+	auto start = clock_t_::now();
+	for (key_t_ k : lookups) checksum += find(table, k);
+	return std::chrono::duration<double, std::nano>(clock_t_::now() - start).count() / lookups.size();
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::mt19937_64 generator{ 42 };
+
+	// odd keys are inserted, even keys are absent
+	std::vector<key_t_> keys(entries);
+	for (auto& k : keys) k = generator() | 1;
+
+	data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_, std::hash<key_t_>> chaining{};
+	data_structures_cpp::swiss_hash_table<key_t_, key_t_, std::hash<key_t_>> swiss{};
+	data_structures_cpp::robin_hood_hash_table<key_t_, key_t_, std::hash<key_t_>> robin_hood{};
+	for (key_t_ k : keys)
+	{
+		chaining.put(k, k);
+		swiss.put(k, k);
+		robin_hood.put(k, k);
+	}
+
+	std::uint64_t checksum = 0;
+	std::printf("%zu entries, ns per lookup\n", entries);
+	std::printf("%10s %18s %18s %18s\n", "miss ratio", "separate_chaining", "swiss", "robin_hood");
+	for (int percent : { 0, 25, 50, 75, 90, 100 })
+	{
+		std::vector<key_t_> lookups(entries);
+		std::bernoulli_distribution miss(percent / 100.0);
+		std::uniform_int_distribution<std::size_t> index(0, entries - 1);
+		for (auto& k : lookups) k = miss(generator) ? generator() & ~key_t_(1) : keys[index(generator)];
+
+		double c = lookup_ns(chaining, lookups,
+			[](auto& t, key_t_ k) { auto it = t.find(k, k); return it == t.end() ? key_t_(0) : (*it).value(); }, checksum);
+		double s = lookup_ns(swiss, lookups,
+			[](auto& t, key_t_ k) { auto it = t.find(k); return it == t.end() ? key_t_(0) : it->value(); }, checksum);
+		double r = lookup_ns(robin_hood, lookups,
+			[](auto& t, key_t_ k) { auto it = t.find(k); return it == t.end() ? key_t_(0) : it->value(); }, checksum);
+		std::printf("%9d%% %18.1f %18.1f %18.1f\n", percent, c, s, r);
+	}
+	std::printf("(checksum %llu)\n", static_cast<unsigned long long>(checksum));
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "map/separate_chaining_hash_table.h"
+
+/*
+ * latency distribution of single insertions into a separate_chaining_hash_table
+ * growing from its default size, with immediate and incremental rehashing.
+ * usage: bench_hash_table_rehash_latency [entries, default 10M]
+ */
+using key_t_ = std::uint64_t;
+using clock_t_ = std::chrono::steady_clock;
+
+double percentile(std::vector<double>& latencies, double p)
+{
+	auto nth = latencies.begin() + static_cast<std::size_t>(p * (latencies.size() - 1));
+	std::nth_element(latencies.begin(), nth, latencies.end());
+	return *nth;
+}
+
+template <class Rehash>
+void measure(char const* name, std::vector<key_t_> const& keys)
+{
+	data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_, std::hash<key_t_>, Rehash> table{};
+	std::vector<double> latencies(keys.size());
+	auto total_start = clock_t_::now();
+	for (std::size_t i = 0; i < keys.size(); ++i)
+	{
+		auto start = clock_t_::now();
+		table.put(keys[i], i);
+		latencies[i] = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count();
+	}
+	double total = std::chrono::duration<double, std::milli>(clock_t_::now() - total_start).count();
+	double max = *std::max_element(latencies.begin(), latencies.end());
+	std::printf("%-12s %12.1f %10.1f %10.1f %10.1f %14.1f\n", name, total,
+		percentile(latencies, 0.5), percentile(latencies, 0.99), percentile(latencies, 0.999), max);
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::mt19937_64 generator{ 42 };
+	std::vector<key_t_> keys(entries);
+	for (auto& k : keys) k = generator();
+
+	std::printf("%zu insertions, latencies in ns\n", entries);
+	std::printf("%-12s %12s %10s %10s %10s %14s\n", "rehash", "total (ms)", "p50", "p99", "p99.9", "max");
+	measure<data_structures_cpp::rehash_tags::immediate>("immediate", keys);
+	measure<data_structures_cpp::rehash_tags::incremental>("incremental", keys);
+	return 0;
+}
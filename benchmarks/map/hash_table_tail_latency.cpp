@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "map/separate_chaining_hash_table.h"
+#include "map/robin_hood_hash_table.h"
+#include "map/cuckoo_hash_table.h"
+
+/*
+ * lookup latency percentiles under key sets that defeat weak hashing (sequential and
+ * power of two strided keys) and a skewed, zipf distributed, choice of keys to look up.
+ * usage: bench_hash_table_tail_latency [entries, default 1M]
+ */
+using key_t_ = std::uint64_t;
+using clock_t_ = std::chrono::steady_clock;
+
+template <class Table, class Find>
+void measure(char const* name, std::vector<key_t_> const& keys, std::vector<key_t_> const& lookups, Find find)
+{
+	Table table{};
+	for (key_t_ k : keys) table.put(k, k);
+	std::vector<double> latencies(lookups.size());
+	std::uint64_t checksum = 0;
+	for (std::size_t i = 0; i < lookups.size(); ++i)
+	{
+		auto start = clock_t_::now();
+		checksum += find(table, lookups[i]);
+		latencies[i] = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count();
+	}
+	std::sort(latencies.begin(), latencies.end());
+	auto at = [&](double p) { return latencies[static_cast<std::size_t>(p * (latencies.size() - 1))]; };
+	std::printf("  %-30s %8.1f %8.1f %8.1f %10.1f   (%llu)\n", name, at(0.5), at(0.99), at(0.999), latencies.back(),
+		static_cast<unsigned long long>(checksum));
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::mt19937_64 generator{ 42 };
+
+	// zipf(0.99) ranks, rank r is looked up with probability proportional to 1 / r^0.99
+	std::vector<double> weights(entries);
+	for (std::size_t r = 0; r < entries; ++r) weights[r] = 1.0 / std::pow(r + 1.0, 0.99);
+	std::discrete_distribution<std::size_t> zipf(weights.begin(), weights.end());
+
+	struct key_set { char const* name; std::vector<key_t_> keys; };
+	std::vector<key_set> key_sets{ { "uniform", {} }, { "sequential", {} }, { "strided by 2^32", {} } };
+	for (std::size_t i = 0; i < entries; ++i)
+	{
+		key_sets[0].keys.push_back(generator());
+		key_sets[1].keys.push_back(i);
+		key_sets[2].keys.push_back(static_cast<key_t_>(i) << 32);
+	}
+
+	std::printf("%zu entries, zipf(0.99) lookups, ns per lookup\n", entries);
+	for (auto const& set : key_sets)
+	{
+		std::vector<key_t_> lookups(entries);
+		for (auto& k : lookups) k = set.keys[zipf(generator)];
+		std::printf("%s keys\n  %-30s %8s %8s %8s %10s\n", set.name, "table", "p50", "p99", "p99.9", "max");
+		measure<data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_, std::hash<key_t_>>>(
+			"separate_chaining_hash_table", set.keys, lookups, [](auto& t, key_t_ k) { return (*t.find(k)).value(); });
+		measure<data_structures_cpp::robin_hood_hash_table<key_t_, key_t_, std::hash<key_t_>>>(
+			"robin_hood_hash_table", set.keys, lookups, [](auto& t, key_t_ k) { return t.find(k)->value(); });
+		measure<data_structures_cpp::cuckoo_hash_table<key_t_, key_t_, std::hash<key_t_>>>(
+			"cuckoo_hash_table", set.keys, lookups, [](auto& t, key_t_ k) { return t.find(k)->value(); });
+	}
+	return 0;
+}
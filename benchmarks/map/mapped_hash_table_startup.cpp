@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "map/mapped_hash_table.h"
+#include "map/separate_chaining_hash_table.h"
+
+/*
+ * startup cost of a large lookup table: rebuilding a separate_chaining_hash_table with put
+ * against opening a mapped_hash_table image, then lookup latency on the mapping, first with
+ * the image evicted from the page cache and then warm. Rebuilding is measured on at most
+ * 20M entries, which fit in memory, and extrapolated linearly to the full table.
+ * usage: bench_mapped_hash_table_startup [entries, default 150M (a 4.5 GB image)] [image path]
+ */
+using key_t_ = std::uint64_t;
+using clock_t_ = std::chrono::steady_clock;
+
+// distinct keys spread over the whole key space, key i is recomputed when looking it up
+key_t_ key(std::uint64_t i) { return i * 0x9e3779b97f4a7c15ull; }
+
+double seconds_since(clock_t_::time_point start) { return std::chrono::duration<double>(clock_t_::now() - start).count(); }
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 150000000;
+	std::string path = argc > 2 ? argv[2] : "mapped_hash_table_startup.bin";
+	std::mt19937_64 generator{ 42 };
+
+	auto start = clock_t_::now();
+	{
+		data_structures_cpp::mapped_hash_table_writer<key_t_, key_t_> writer(path, entries);
+		for (std::size_t i = 0; i < entries; ++i) writer.put(key(i), i);
+		writer.finish();
+	}
+	std::printf("%zu entries\nwriting the image              %10.2f s\n", entries, seconds_since(start));
+
+	std::size_t rebuilt = entries < 20000000 ? entries : 20000000;
+	start = clock_t_::now();
+	{
+		data_structures_cpp::separate_chaining_hash_table<key_t_, key_t_> table{};
+		for (std::size_t i = 0; i < rebuilt; ++i) table.put(key(i), i);
+	}
+	double rebuild = seconds_since(start) * entries / rebuilt;
+	std::printf("rebuilding with put            %10.2f s%s\n", rebuild, rebuilt < entries ? " (extrapolated)" : "");
+
+	// evict the image so that the first lookups read it from disk like a fresh start would
+	int fd = open(path.c_str(), O_RDONLY);
+	fdatasync(fd);
+	posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	close(fd);
+
+	start = clock_t_::now();
+	data_structures_cpp::mapped_hash_table<key_t_, key_t_> table(path);
+	std::printf("opening the image              %10.3f ms\n", seconds_since(start) * 1e3);
+
+	std::uniform_int_distribution<std::uint64_t> index(0, entries - 1);
+	std::uint64_t checksum = 0;
+	for (std::size_t lookups : { std::size_t(1000), std::size_t(1000000) })
+	{
+		start = clock_t_::now();
+		for (std::size_t n = 0; n < lookups; ++n) checksum += *table.find(key(index(generator)));
+		std::printf("%-7zu random lookups          %10.1f ns per lookup\n", lookups, seconds_since(start) * 1e9 / lookups);
+	}
+	std::printf("(%llu)\n", static_cast<unsigned long long>(checksum));
+	std::remove(path.c_str());
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "map/static_perfect_hash_map.h"
+#include "map/robin_hood_hash_table.h"
+
+/*
+ * construction time of a static_perfect_hash_map by number of threads, the size of its
+ * perfect hash, and its lookup latency against a robin_hood_hash_table of the same entries.
+ * usage: bench_static_perfect_hash_map_build [entries, default 10M] [max threads, default all]
+ */
+using key_t_ = std::uint64_t;
+using entry_t = data_structures_cpp::key_value_pair<key_t_, key_t_>;
+using clock_t_ = std::chrono::steady_clock;
+
+double seconds_since(clock_t_::time_point start) { return std::chrono::duration<double>(clock_t_::now() - start).count(); }
+
+template <class Find>
+double lookup_ns(std::vector<key_t_> const& lookups, Find find)
+{
+	std::uint64_t checksum = 0;
+	auto start = clock_t_::now();
+	for (key_t_ k : lookups) checksum += find(k);
+	double ns = seconds_since(start) * 1e9 / lookups.size();
+	if (checksum == 42) std::printf("(%llu)\n", static_cast<unsigned long long>(checksum));
+	return ns;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t entries = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+	std::mt19937_64 generator{ 42 };
+	std::vector<entry_t> source{};
+	for (std::size_t i = 0; i < entries; ++i) source.emplace_back(generator(), i);
+
+	std::printf("%zu entries\n%-10s %12s %12s\n", entries, "threads", "build (s)", "bits/key");
+	for (std::size_t threads = 1; threads <= max_threads; threads *= 2)
+	{
+		auto start = clock_t_::now();
+		data_structures_cpp::static_perfect_hash_map<key_t_, key_t_> map(source, threads);
+		std::printf("%-10zu %12.2f %12.2f\n", threads, seconds_since(start), map.bits_per_key());
+	}
+
+	data_structures_cpp::static_perfect_hash_map<key_t_, key_t_> map(source, max_threads);
+	data_structures_cpp::robin_hood_hash_table<key_t_, key_t_> table{};
+	for (auto const& e : source) table.put(e.key(), e.value());
+	std::vector<key_t_> lookups(1000000);
+	for (auto& k : lookups) k = source[generator() % entries].key();
+	std::printf("ns per lookup\n  %-28s %8.1f\n  %-28s %8.1f\n",
+		"static_perfect_hash_map", lookup_ns(lookups, [&](key_t_ k) { return map.find(k)->value(); }),
+		"robin_hood_hash_table", lookup_ns(lookups, [&](key_t_ k) { return table.find(k)->value(); }));
+	return 0;
+}
\ No newline at end of file
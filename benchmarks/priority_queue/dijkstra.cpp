@@ -0,0 +1,117 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "priority_queue/adaptable_priority_queue.h"
+#include "priority_queue/vector_priority_queue.h"
+
+/*
+ * Dijkstra's shortest paths over a random graph, with an adaptable_priority_queue whose
+ * tentative distances are lowered by decrease_key, against a vector_priority_queue into
+ * which improved distances are pushed again and stale entries skipped when popped.
+ * usage: bench_dijkstra [nodes, default 1M] [edges per node, default 4]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+struct edge
+{
+	std::uint32_t to_;
+	std::uint32_t weight_;
+};
+
+struct label
+{
+	std::uint64_t distance_;
+	std::uint32_t node_;
+	bool operator<(label const& rhs) const { return distance_ < rhs.distance_; }
+};
+
+using graph_t = std::vector<std::vector<edge>>;
+constexpr std::uint64_t unreached = std::numeric_limits<std::uint64_t>::max();
+
+template <std::size_t Arity>
+std::vector<std::uint64_t> with_decrease_key(graph_t const& graph)
+{
+	std::vector<std::uint64_t> distance(graph.size(), unreached);
+	// positions of the nodes reached so far, in the order they were reached
+	std::vector<data_structures_cpp::position<label>> positions{};
+	std::vector<std::uint32_t> reached(graph.size(), 0);
+	std::vector<bool> queued(graph.size(), false);
+	data_structures_cpp::adaptable_priority_queue<label, std::less<label>, Arity> queue{};
+	distance[0] = 0;
+	positions.push_back(queue.insert(label{ 0, 0 }));
+	queued[0] = true;
+	while (!queue.empty())
+	{
+		label l = queue.pop_value();
+		queued[l.node_] = false;
+		for (edge const& e : graph[l.node_])
+		{
+			std::uint64_t d = l.distance_ + e.weight_;
+			if (d >= distance[e.to_]) continue;
+			bool first_time = distance[e.to_] == unreached;
+			distance[e.to_] = d;
+			if (first_time)
+			{
+				reached[e.to_] = static_cast<std::uint32_t>(positions.size());
+				positions.push_back(queue.insert(label{ d, e.to_ }));
+			}
+			else if (queued[e.to_]) queue.decrease_key(positions[reached[e.to_]], label{ d, e.to_ });
+			queued[e.to_] = true;
+		}
+	}
+	return distance;
+}
+
+std::vector<std::uint64_t> with_lazy_deletion(graph_t const& graph)
+{
+	std::vector<std::uint64_t> distance(graph.size(), unreached);
+	data_structures_cpp::vector_priority_queue<label, std::less<label>, 4> queue{};
+	distance[0] = 0;
+	queue.push(label{ 0, 0 });
+	while (!queue.empty())
+	{
+		label l = queue.pop_value();
+		if (l.distance_ != distance[l.node_]) continue;
+		for (edge const& e : graph[l.node_])
+		{
+			std::uint64_t d = l.distance_ + e.weight_;
+			if (d >= distance[e.to_]) continue;
+			distance[e.to_] = d;
+			queue.push(label{ d, e.to_ });
+		}
+	}
+	return distance;
+}
+
+template <class F>
+void measure(char const* name, graph_t const& graph, std::vector<std::uint64_t> const& expected, F f)
+{
+	auto start = clock_t_::now();
+	std::vector<std::uint64_t> distance = f(graph);
+	double ms = std::chrono::duration<double, std::milli>(clock_t_::now() - start).count();
+	std::printf("  %-44s %10.1f%s\n", name, ms, expected.empty() || distance == expected ? "" : "   (wrong distances)");
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t nodes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::size_t degree = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4;
+	std::mt19937_64 generator{ 42 };
+	graph_t graph(nodes);
+	for (auto& edges : graph)
+	{
+		for (std::size_t i = 0; i < degree; ++i) edges.push_back(edge{ static_cast<std::uint32_t>(generator() % nodes), static_cast<std::uint32_t>(generator() % 1000 + 1) });
+	}
+	std::vector<std::uint64_t> expected = with_lazy_deletion(graph);
+	std::printf("%zu nodes, %zu edges per node, ms\n", nodes, degree);
+	measure("adaptable_priority_queue<2>, decrease_key", graph, expected, with_decrease_key<2>);
+	measure("adaptable_priority_queue<4>, decrease_key", graph, expected, with_decrease_key<4>);
+	measure("vector_priority_queue<4>, lazy deletion", graph, {}, with_lazy_deletion);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iterator>
+#include <functional>
+
+#include "priority_queue/vector_priority_queue.h"
+
+/*
+ * rebuilding a vector_priority_queue of re-prioritised jobs with one push per job against
+ * the range constructor, and taking the front jobs with pop against pop_n.
+ * usage: bench_heap_build [jobs, default 10M]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+struct job
+{
+	std::uint64_t priority_;
+	std::uint64_t id_;
+	bool operator<(job const& rhs) const { return priority_ < rhs.priority_; }
+};
+
+using queue_t = data_structures_cpp::vector_priority_queue<job, std::less<job>, 4>;
+
+template <class F>
+double milliseconds(F f)
+{
+	auto start = clock_t_::now();
+	f();
+	return std::chrono::duration<double, std::milli>(clock_t_::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+	std::mt19937_64 generator{ 42 };
+	std::vector<job> jobs(n);
+	for (std::size_t i = 0; i < n; ++i) jobs[i] = job{ generator(), i };
+
+	std::printf("%zu jobs, 4-ary heap, ms\n", n);
+	std::printf("  %-36s %10.1f\n", "rebuild with n pushes", milliseconds([&]
+	{
+		queue_t queue{};
+		for (job const& j : jobs) queue.push(j);
+	}));
+	std::printf("  %-36s %10.1f\n", "rebuild with the range constructor", milliseconds([&] { queue_t queue(jobs.begin(), jobs.end()); }));
+
+	for (std::size_t k : { n / 100, n / 2 })
+	{
+		queue_t popped(jobs.begin(), jobs.end()), batched(jobs.begin(), jobs.end());
+		std::vector<job> out{};
+		out.reserve(k);
+		double one_by_one = milliseconds([&]
+		{
+			for (std::size_t i = 0; i < k; ++i, popped.pop()) out.push_back(popped.front());
+		});
+		out.clear();
+		double at_once = milliseconds([&] { batched.pop_n(k, std::back_inserter(out)); });
+		std::printf("  front %-8zu with pop %10.1f, with pop_n %10.1f\n", k, one_by_one, at_once);
+	}
+	return 0;
+}
\ No newline at end of file
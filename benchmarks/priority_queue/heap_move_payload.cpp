@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include "priority_queue/vector_priority_queue.h"
+#include "priority_queue/list_priority_queue.h"
+
+/*
+ * priority queues of job descriptors owning a 256 byte payload, fed and drained by copy
+ * (push(T const&), front() then pop()) or by move (push(T&&), pop_value()).
+ * usage: bench_heap_move_payload [jobs, default 1M]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+struct job
+{
+	std::uint64_t priority_;
+	std::string payload_;
+	bool operator<(job const& rhs) const { return priority_ < rhs.priority_; }
+};
+
+std::vector<job> make_jobs(std::size_t n)
+{
+	std::mt19937_64 generator{ 42 };
+	std::vector<job> jobs(n);
+	for (job& j : jobs) j = job{ generator(), std::string(256, 'p') };
+	return jobs;
+}
+
+template <class Queue>
+double by_copy(std::vector<job> jobs)
+{
+	Queue queue{};
+	std::size_t checksum = 0;
+	auto start = clock_t_::now();
+	for (job const& j : jobs) queue.push(j);
+	while (!queue.empty())
+	{
+		job j = queue.front();
+		queue.pop();
+		checksum += j.payload_.size();
+	}
+	double ns = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count() / jobs.size();
+	return checksum == jobs.size() * 256 ? ns : -1;
+}
+
+template <class Queue>
+double by_move(std::vector<job> jobs)
+{
+	Queue queue{};
+	std::size_t checksum = 0;
+	auto start = clock_t_::now();
+	for (job& j : jobs) queue.push(std::move(j));
+	while (!queue.empty()) checksum += queue.pop_value().payload_.size();
+	double ns = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count() / jobs.size();
+	return checksum == jobs.size() * 256 ? ns : -1;
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::vector<job> jobs = make_jobs(n);
+	using vector_queue_t = data_structures_cpp::vector_priority_queue<job, std::less<job>, 4>;
+	using list_queue_t = data_structures_cpp::list_priority_queue<job>;
+	std::printf("%zu jobs with a 256 byte payload, ns per push + pop\n  %-24s %10s %10s\n", n, "queue", "copy", "move");
+	std::printf("  %-24s %10.1f %10.1f\n", "vector_priority_queue<4>", by_copy<vector_queue_t>(jobs), by_move<vector_queue_t>(jobs));
+	// the list queue inserts in O(n), it is measured on fewer jobs
+	std::vector<job> few(jobs.begin(), jobs.begin() + (n < 5000 ? n : 5000));
+	std::printf("  %-24s %10.1f %10.1f   (%zu jobs)\n", "list_priority_queue", by_copy<list_queue_t>(few), by_move<list_queue_t>(few), few.size());
+	return 0;
+}
\ No newline at end of file
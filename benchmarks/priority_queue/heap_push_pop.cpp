@@ -0,0 +1,80 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <queue>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "priority_queue/vector_priority_queue.h"
+
+/*
+ * vector_priority_queue by arity against std::priority_queue on two workloads:
+ * the hold model of an event scheduler (pop the earliest event, push one scheduled a
+ * random delay later, the queue size stays constant) and pushing then popping everything.
+ * usage: bench_heap_push_pop [queue size, default 1M]
+ */
+using clock_t_ = std::chrono::steady_clock;
+
+struct event
+{
+	double time_;
+	std::uint64_t id_;
+	bool operator<(event const& rhs) const { return time_ < rhs.time_; }
+	bool operator>(event const& rhs) const { return time_ > rhs.time_; }
+};
+
+// std::priority_queue is a max heap and has top() instead of front()
+struct std_queue : std::priority_queue<event, std::vector<event>, std::greater<event>>
+{
+	event const& front() const { return top(); }
+};
+
+template <class Queue>
+void measure(char const* name, std::size_t n)
+{
+	// delays are drawn up front so that only the queue is timed
+	std::mt19937_64 generator{ 42 };
+	std::exponential_distribution<double> distribution{ 1.0 };
+	std::vector<double> delays(1 << 16);
+	for (double& d : delays) d = distribution(generator) * n;
+	auto delay = [&](std::size_t i) { return delays[i & (delays.size() - 1)]; };
+	Queue queue{};
+	for (std::size_t i = 0; i < n; ++i) queue.push(event{ delay(i), i });
+
+	std::size_t steps = 4 * n;
+	double checksum = 0;
+	auto start = clock_t_::now();
+	for (std::size_t i = 0; i < steps; ++i)
+	{
+		event e = queue.front();
+		queue.pop();
+		checksum += e.time_;
+		queue.push(event{ e.time_ + delay(i), e.id_ });
+	}
+	double hold = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count() / steps;
+
+	start = clock_t_::now();
+	while (!queue.empty())
+	{
+		checksum += queue.front().time_;
+		queue.pop();
+	}
+	for (std::size_t i = 0; i < n; ++i) queue.push(event{ delay(i * 7), i });
+	double drain = std::chrono::duration<double, std::nano>(clock_t_::now() - start).count() / n;
+	std::printf("  %-24s %12.1f %18.1f   (%g)\n", name, hold, drain, checksum);
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::printf("%zu events of %zu bytes, ns per operation\n  %-24s %12s %18s\n",
+		n, sizeof(event), "queue", "pop + push", "pop all + push all");
+	measure<std_queue>("std::priority_queue", n);
+	measure<data_structures_cpp::vector_priority_queue<event, std::less<event>, 2>>("vector_priority_queue<2>", n);
+	measure<data_structures_cpp::vector_priority_queue<event, std::less<event>, 4>>("vector_priority_queue<4>", n);
+	measure<data_structures_cpp::vector_priority_queue<event, std::less<event>, 8>>("vector_priority_queue<8>", n);
+	measure<data_structures_cpp::vector_priority_queue<event, std::less<event>, 16>>("vector_priority_queue<16>", n);
+	return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <iterator>
+#include <functional>
+
+#include "priority_queue/pairing_heap.h"
+#include "priority_queue/vector_priority_queue.h"
+#include "priority_queue/adaptable_priority_queue.h"
+
+/*
+ * pairing_heap against the heaps built on arrays, on two workloads:
+ * consolidating shards, queues of n / shards elements each merged into one, with meld
+ * for the pairing heap and by moving every element over for the others,
+ * and decrease_key, n elements lowered 4 times each in random order, then drained.
+ * usage: bench_pairing_heap [elements, default 1M] [shards, default 64]
+ */
+using clock_t_ = std::chrono::steady_clock;
+using value_t = std::uint64_t;
+
+double elapsed_ms(clock_t_::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(clock_t_::now() - start).count();
+}
+
+std::vector<std::vector<value_t>> make_shards(std::size_t n, std::size_t shards)
+{
+	std::mt19937_64 generator{ 42 };
+	std::vector<std::vector<value_t>> values(shards);
+	for (std::size_t i = 0; i < n; ++i) values[i % shards].push_back(generator());
+	return values;
+}
+
+template <class Queue, class Push, class Merge>
+void consolidate(char const* name, std::vector<std::vector<value_t>> const& values, Push push, Merge merge)
+{
+	std::vector<Queue> shards(values.size());
+	for (std::size_t s = 0; s < values.size(); ++s)
+	{
+		for (value_t v : values[s]) push(shards[s], v);
+	}
+	Queue all{};
+	auto start = clock_t_::now();
+	for (Queue& shard : shards) merge(all, shard);
+	double ms = elapsed_ms(start);
+	value_t previous = 0;
+	bool sorted = true;
+	while (!all.empty())
+	{
+		value_t v = all.pop_value();
+		sorted = sorted && previous <= v;
+		previous = v;
+	}
+	std::printf("  %-48s %10.3f%s\n", name, ms, sorted ? "" : "   (out of order)");
+}
+
+template <class Queue, class Insert>
+void decrease_keys(char const* name, std::size_t n, Insert insert)
+{
+	std::mt19937_64 generator{ 7 };
+	Queue queue{};
+	std::vector<decltype(insert(queue, 0))> positions{};
+	positions.reserve(n);
+	auto start = clock_t_::now();
+	for (std::size_t i = 0; i < n; ++i) positions.push_back(insert(queue, (generator() >> 2) + (value_t(1) << 62)));
+	for (std::size_t round = 0; round < 4; ++round)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			auto& p = positions[generator() % n];
+			queue.decrease_key(p, *p - (*p >> 4) * (generator() % 8) / 8);
+		}
+	}
+	value_t previous = 0;
+	bool sorted = true;
+	while (!queue.empty())
+	{
+		value_t v = queue.pop_value();
+		sorted = sorted && previous <= v;
+		previous = v;
+	}
+	std::printf("  %-48s %10.1f%s\n", name, elapsed_ms(start), sorted ? "" : "   (out of order)");
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+	std::size_t shard_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+	using pairing_t = data_structures_cpp::pairing_heap<value_t>;
+	using vector_t = data_structures_cpp::vector_priority_queue<value_t, std::less<value_t>, 4>;
+	using adaptable_t = data_structures_cpp::adaptable_priority_queue<value_t>;
+
+	auto values = make_shards(n, shard_count);
+	std::printf("%zu elements in %zu shards, ms to merge them into one queue\n", n, shard_count);
+	consolidate<pairing_t>("pairing_heap, meld", values,
+		[](pairing_t& q, value_t v) { q.push(v); },
+		[](pairing_t& all, pairing_t& shard) { all.meld(shard); });
+	consolidate<vector_t>("vector_priority_queue<4>, pop and push", values,
+		[](vector_t& q, value_t v) { q.push(v); },
+		[](vector_t& all, vector_t& shard) { while (!shard.empty()) all.push(shard.pop_value()); });
+	consolidate<vector_t>("vector_priority_queue<4>, pop_n and push_range", values,
+		[](vector_t& q, value_t v) { q.push(v); },
+		[](vector_t& all, vector_t& shard)
+		{
+			std::vector<value_t> moved{};
+			shard.pop_n(shard.size(), std::back_inserter(moved));
+			all.push_range(moved.begin(), moved.end());
+		});
+	consolidate<adaptable_t>("adaptable_priority_queue, pop and insert", values,
+		[](adaptable_t& q, value_t v) { q.insert(v); },
+		[](adaptable_t& all, adaptable_t& shard) { while (!shard.empty()) all.insert(shard.pop_value()); });
+
+	std::printf("%zu elements, %zu decrease_key, ms for inserting, decreasing and popping\n", n, 4 * n);
+	using adaptable4_t = data_structures_cpp::adaptable_priority_queue<value_t, std::less<value_t>, 4>;
+	decrease_keys<pairing_t>("pairing_heap", n, [](pairing_t& q, value_t v) { return q.push(v); });
+	decrease_keys<adaptable_t>("adaptable_priority_queue<2>", n, [](adaptable_t& q, value_t v) { return q.insert(v); });
+	decrease_keys<adaptable4_t>("adaptable_priority_queue<4>", n, [](adaptable4_t& q, value_t v) { return q.insert(v); });
+	return 0;
+}
\ No newline at end of file
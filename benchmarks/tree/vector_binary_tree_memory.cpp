@@ -0,0 +1,38 @@
+#include <cstdio>
+#include <cstddef>
+
+#include "tree/vector_binary_tree.h"
+
+/*
+ * memory used by vector_binary_tree to hold a degenerate chain,
+ * each level expands the right child of the previous one
+ */
+template <class Storage>
+void chain(int depth)
+{
+	data_structures_cpp::vector_binary_tree<int, Storage> tree{};
+	tree.add_root();
+	auto pos = tree.root();
+	for (int d = 0; d < depth; ++d)
+	{
+		tree.expand_external(pos);
+		pos = pos.right();
+	}
+	// queries must not change the footprint
+	for (auto const& p : tree.positions()) p.external();
+	std::printf("%6d %8zu %14zu %16zu\n", depth, tree.size(), tree.storage().slots(), tree.storage().memory_usage());
+}
+
+int main()
+{
+	// a dense chain of depth d needs 2^(d+1) slots, beyond 24 levels it no longer fits in memory
+	int const max_dense_depth = 24;
+	int const max_depth = 40;
+
+	std::printf("dense_node_storage\n%6s %8s %14s %16s\n", "depth", "nodes", "slots", "bytes");
+	for (int depth = 4; depth <= max_dense_depth; depth += 4) chain<data_structures_cpp::dense_node_storage<int>>(depth);
+
+	std::printf("\nsparse_node_storage\n%6s %8s %14s %16s\n", "depth", "nodes", "slots", "bytes");
+	for (int depth = 4; depth <= max_depth; depth += 4) chain<data_structures_cpp::sparse_node_storage<int>>(depth);
+	return 0;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+#include <cstddef>
+
+#include "separate_chaining_hash_table.h"
+
+namespace data_structures_cpp {
+
+/*
+ * hash map safe to use from many threads, sharded into independent
+ * separate_chaining_hash_tables each guarded by its own reader/writer lock.
+ * The high bits of a key's hash pick its shard, the table of the shard uses the low bits,
+ * so operations on different shards never contend and a rehash only stalls one shard.
+ * for_each locks one shard at a time, writers are only held back on the shard being visited.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class concurrent_hash_map
+{
+public:
+	using table_t = separate_chaining_hash_table<K, V, Hasher>;
+
+	// shards is rounded up to a power of two, a few times the number of threads avoids contention
+	explicit concurrent_hash_map(std::size_t shards = 64)
+	{
+		while ((std::size_t(1) << shard_bits_) < shards) ++shard_bits_;
+		shards_.reset(new shard[std::size_t(1) << shard_bits_]);
+	}
+
+	concurrent_hash_map(concurrent_hash_map const& rhs) = delete;
+	concurrent_hash_map& operator=(concurrent_hash_map const& rhs) = delete;
+
+	std::size_t shard_count() const { return std::size_t(1) << shard_bits_; }
+
+	// number of entries, exact only when no update is in flight
+	std::size_t size() const
+	{
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < shard_count(); ++i)
+		{
+			std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+			n += shards_[i].table_.size();
+		}
+		return n;
+	}
+	bool empty() const { return size() == 0; }
+
+	std::optional<V> find(K const& k) const
+	{
+		precomputed_hash h = hash_of(k);
+		shard& s = shard_of(h);
+		std::shared_lock<std::shared_mutex> lock(s.mutex_);
+		auto it = s.table_.find(k, h);
+		if (it == s.table_.end()) return std::nullopt;
+		return (*it).value();
+	}
+
+	bool contains(K const& k) const { return find(k).has_value(); }
+
+	// inserts k only if it is absent, returns whether it was inserted
+	bool insert(K const& k, V const& v)
+	{
+		precomputed_hash h = hash_of(k);
+		shard& s = shard_of(h);
+		std::unique_lock<std::shared_mutex> lock(s.mutex_);
+		if (s.table_.find(k, h) != s.table_.end()) return false;
+		s.table_.put(k, v);
+		return true;
+	}
+
+	// inserts k or overwrites its value
+	void put(K const& k, V const& v)
+	{
+		shard& s = shard_of(hash_of(k));
+		std::unique_lock<std::shared_mutex> lock(s.mutex_);
+		s.table_.put(k, v);
+	}
+
+	// returns whether k was present
+	bool erase(K const& k)
+	{
+		precomputed_hash h = hash_of(k);
+		shard& s = shard_of(h);
+		std::unique_lock<std::shared_mutex> lock(s.mutex_);
+		auto it = s.table_.find(k, h);
+		if (it == s.table_.end()) return false;
+		s.table_.erase(it);
+		return true;
+	}
+
+	/*
+	 * calls f(key, value) for every entry, shard after shard. Each shard is seen in a
+	 * consistent state, but updates made to other shards meanwhile may or may not be seen.
+	 * f must not call back into the map.
+	 */
+	template <class F>
+	void for_each(F f) const
+	{
+		for (std::size_t i = 0; i < shard_count(); ++i)
+		{
+			std::shared_lock<std::shared_mutex> lock(shards_[i].mutex_);
+			for (auto it = shards_[i].table_.begin(); it != shards_[i].table_.end(); ++it) f((*it).key(), (*it).value());
+		}
+	}
+
+private:
+	// padded to a cache line so that locking a shard does not invalidate its neighbours
+	struct alignas(64) shard
+	{
+		mutable std::shared_mutex mutex_;
+		table_t table_{ 16 };
+	};
+
+	precomputed_hash hash_of(K const& k) const { return shards_[0].table_.hash_of(k); }
+
+	shard& shard_of(precomputed_hash h) const
+	{
+		return shards_[shard_bits_ == 0 ? 0 : h.value >> (sizeof(std::size_t) * 8 - shard_bits_)];
+	}
+
+	std::size_t shard_bits_{ 0 };
+	std::unique_ptr<shard[]> shards_{};
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,334 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <random>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "utils/utils.h"
+#include "utils/thread_index.h"
+
+namespace data_structures_cpp {
+
+/*
+ * ordered map based on the lazy skip list of Herlihy, Lev, Luchangco and Shavit.
+ * find, contains and lower_bound never lock nor retry and are thus wait-free.
+ * insert and erase lock only the predecessors of the node they link or unlink,
+ * after validating optimistically that those predecessors are still adjacent to it.
+ *
+ * Erased nodes are reclaimed by epochs: every operation announces the global epoch
+ * in its thread's own cache line, an erase stamps its node with the epoch it was unlinked in
+ * and advances the global epoch once every announced thread has caught up with it.
+ * A node unlinked in epoch e is freed when the global epoch reaches e + 2,
+ * by then no operation that could have reached it is still running.
+ * Readers thus never write a cache line shared with other threads.
+ */
+template <class K, class V, int MaxLevel = 32>
+class concurrent_skip_list_map
+{
+public:
+	using entry_t = key_value_pair<K, V>;
+	using key_type = typename entry_t::key_type;
+	using value_type = typename entry_t::value_type;
+private:
+	struct node
+	{
+		node(key_type const& k, value_type const& v, int top_level)
+			: entry_(k, v), top_level_(top_level), next_(top_level + 1)
+		{}
+
+		entry_t const entry_;
+		int const top_level_;
+		std::vector<std::atomic<node*>> next_;
+		std::atomic<bool> marked_{ false };
+		std::atomic<bool> fully_linked_{ false };
+		std::mutex lock_;
+	};
+
+	static constexpr std::uint64_t quiescent = 0;
+
+	// epoch announced by a thread, quiescent while it runs no operation on the map
+	struct alignas(64) epoch_slot
+	{
+		std::atomic<std::uint64_t> epoch_{ quiescent };
+	};
+
+	// announces the current epoch in the calling thread's slot for the duration of an operation
+	class operation_guard
+	{
+	public:
+		explicit operation_guard(concurrent_skip_list_map const& map)
+			: slot_(map.slots_[this_thread_index()].epoch_)
+		{
+			// re-announce until the epoch did not move, so that no advance can miss this thread
+			std::uint64_t epoch = 0;
+			do
+			{
+				epoch = map.epoch_.load();
+				slot_.store(epoch);
+			} while (map.epoch_.load() != epoch);
+		}
+		~operation_guard() { slot_.store(quiescent); }
+	private:
+		std::atomic<std::uint64_t>& slot_;
+	};
+public:
+	explicit concurrent_skip_list_map() : head_(new node(key_type(), value_type(), MaxLevel - 1)) {}
+
+	concurrent_skip_list_map(concurrent_skip_list_map const& rhs) = delete;
+	concurrent_skip_list_map& operator=(concurrent_skip_list_map const& rhs) = delete;
+
+	~concurrent_skip_list_map()
+	{
+		node* v = head_;
+		while (v)
+		{
+			node* next = v->next_[0].load();
+			delete v;
+			v = next;
+		}
+		for (auto const& retired : retired_) delete retired.first;
+	}
+
+	// number of entries, exact only when no update is in flight
+	std::size_t size() const { return size_.load(); }
+	bool empty() const { return size() == 0; }
+
+	// number of erased nodes not yet freed
+	std::size_t retired_count() const
+	{
+		std::lock_guard<std::mutex> lock(retired_lock_);
+		return retired_.size();
+	}
+
+	bool contains(key_type const& k) const
+	{
+		operation_guard guard(*this);
+		node* preds[MaxLevel];
+		node* succs[MaxLevel];
+		int level = finder(k, preds, succs);
+		return level != -1 && succs[level]->fully_linked_.load() && !succs[level]->marked_.load();
+	}
+
+	std::optional<value_type> find(key_type const& k) const
+	{
+		operation_guard guard(*this);
+		node* preds[MaxLevel];
+		node* succs[MaxLevel];
+		int level = finder(k, preds, succs);
+		if (level == -1 || !succs[level]->fully_linked_.load() || succs[level]->marked_.load()) return std::nullopt;
+		return succs[level]->entry_.value_;
+	}
+
+	// first entry whose key is not less than k
+	std::optional<entry_t> lower_bound(key_type const& k) const
+	{
+		operation_guard guard(*this);
+		node* preds[MaxLevel];
+		node* succs[MaxLevel];
+		finder(k, preds, succs);
+		node* v = succs[0];
+		while (v && (v->marked_.load() || !v->fully_linked_.load())) v = v->next_[0].load();
+		if (!v) return std::nullopt;
+		return v->entry_;
+	}
+
+	// returns false, leaving the map unchanged, if k is already present
+	bool insert(key_type const& k, value_type const& v)
+	{
+		operation_guard guard(*this);
+		int top_level = random_level();
+		node* preds[MaxLevel];
+		node* succs[MaxLevel];
+		while (true)
+		{
+			int level = finder(k, preds, succs);
+			if (level != -1)
+			{
+				node* found = succs[level];
+				if (!found->marked_.load())
+				{
+					while (!found->fully_linked_.load()) {}
+					return false;
+				}
+				continue; // found is being erased, retry until it is unlinked
+			}
+
+			int highest_locked = -1;
+			bool valid = true;
+			for (int l = 0; valid && l <= top_level; ++l)
+			{
+				node* pred = preds[l];
+				node* succ = succs[l];
+				if (l == 0 || pred != preds[l - 1]) pred->lock_.lock();
+				highest_locked = l;
+				valid = !pred->marked_.load() && (succ == nullptr || !succ->marked_.load()) && pred->next_[l].load() == succ;
+			}
+			if (!valid)
+			{
+				unlock(preds, highest_locked);
+				continue;
+			}
+
+			node* inserted = new node(k, v, top_level);
+			for (int l = 0; l <= top_level; ++l) inserted->next_[l].store(succs[l]);
+			for (int l = 0; l <= top_level; ++l) preds[l]->next_[l].store(inserted);
+			inserted->fully_linked_.store(true);
+			unlock(preds, highest_locked);
+			++size_;
+			return true;
+		}
+	}
+
+	// returns false if k is not present
+	bool erase(key_type const& k)
+	{
+		bool erased = false;
+		{
+			operation_guard guard(*this);
+			erased = eraser(k);
+		}
+		if (erased) reclaim();
+		return erased;
+	}
+
+protected:
+	// fills predecessors and successors of k at every level, returns the highest level k was found at or -1
+	int finder(key_type const& k, node** preds, node** succs) const
+	{
+		int found = -1;
+		node* pred = head_;
+		for (int l = MaxLevel - 1; l >= 0; --l)
+		{
+			node* curr = pred->next_[l].load();
+			while (curr && curr->entry_.key_ < k)
+			{
+				pred = curr;
+				curr = pred->next_[l].load();
+			}
+			if (found == -1 && curr && !(k < curr->entry_.key_)) found = l;
+			preds[l] = pred;
+			succs[l] = curr;
+		}
+		return found;
+	}
+
+	bool eraser(key_type const& k)
+	{
+		node* victim = nullptr;
+		bool marked = false;
+		int top_level = -1;
+		node* preds[MaxLevel];
+		node* succs[MaxLevel];
+		while (true)
+		{
+			int level = finder(k, preds, succs);
+			if (!marked)
+			{
+				if (level == -1) return false;
+				victim = succs[level];
+				// only erase nodes that are fully linked and found at their top level
+				if (!victim->fully_linked_.load() || victim->top_level_ != level || victim->marked_.load()) return false;
+				top_level = victim->top_level_;
+				victim->lock_.lock();
+				if (victim->marked_.load())
+				{
+					victim->lock_.unlock();
+					return false;
+				}
+				victim->marked_.store(true);
+				marked = true;
+			}
+
+			int highest_locked = -1;
+			bool valid = true;
+			for (int l = 0; valid && l <= top_level; ++l)
+			{
+				node* pred = preds[l];
+				if (l == 0 || pred != preds[l - 1]) pred->lock_.lock();
+				highest_locked = l;
+				valid = !pred->marked_.load() && pred->next_[l].load() == victim;
+			}
+			if (!valid)
+			{
+				unlock(preds, highest_locked);
+				continue;
+			}
+
+			for (int l = top_level; l >= 0; --l) preds[l]->next_[l].store(victim->next_[l].load());
+			victim->lock_.unlock();
+			unlock(preds, highest_locked);
+			--size_;
+			std::lock_guard<std::mutex> lock(retired_lock_);
+			retired_.emplace_back(victim, epoch_.load());
+			return true;
+		}
+	}
+
+	// advances the global epoch if every thread in an operation announced the current one
+	void try_advance()
+	{
+		std::uint64_t epoch = epoch_.load();
+		std::size_t const threads = thread_index_registry::instance().bound();
+		for (std::size_t i = 0; i < threads; ++i)
+		{
+			std::uint64_t announced = slots_[i].epoch_.load();
+			if (announced != quiescent && announced != epoch) return;
+		}
+		epoch_.compare_exchange_strong(epoch, epoch + 1);
+	}
+
+	// frees retired nodes that no operation can still be traversing
+	void reclaim()
+	{
+		try_advance();
+		std::uint64_t const epoch = epoch_.load();
+		std::vector<node*> reclaimed{};
+		{
+			std::lock_guard<std::mutex> lock(retired_lock_);
+			auto kept = retired_.begin();
+			for (auto it = retired_.begin(); it != retired_.end(); ++it)
+			{
+				if (it->second + 2 <= epoch) reclaimed.push_back(it->first);
+				else *kept++ = *it;
+			}
+			retired_.erase(kept, retired_.end());
+		}
+		for (node* v : reclaimed) delete v;
+	}
+
+	static void unlock(node** preds, int highest_locked)
+	{
+		for (int l = 0; l <= highest_locked; ++l)
+			if (l == 0 || preds[l] != preds[l - 1]) preds[l]->lock_.unlock();
+	}
+
+	// geometric distribution with p = 1/2, capped at MaxLevel - 1
+	static int random_level()
+	{
+		thread_local std::mt19937 generator{ std::random_device{}() };
+		std::uint32_t bits = generator();
+		int level = 0;
+		while ((bits & 1) && level < MaxLevel - 1)
+		{
+			++level;
+			bits >>= 1;
+		}
+		return level;
+	}
+
+private:
+	node* head_;
+	std::atomic<std::size_t> size_{ 0 };
+	// read by every operation, kept apart from size_ which every update writes
+	alignas(64) std::atomic<std::uint64_t> epoch_{ 1 };
+	mutable epoch_slot slots_[max_thread_count]{};
+	mutable std::mutex retired_lock_;
+	std::vector<std::pair<node*, std::uint64_t>> retired_{};
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "separate_chaining_hash_table.h"
+
+namespace data_structures_cpp {
+
+/*
+ * dictionary keeping all values of a key in one contiguous array under a single entry
+ * of a separate_chaining_hash_table. find_all is a single lookup and returns the values
+ * as a contiguous range, instead of walking one list node per value like dictionary does.
+ * Values of a key are kept in insertion order. A range is invalidated by any
+ * insertion or erasure of its key and by rehashing.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class contiguous_dictionary
+{
+	static_assert(!std::is_same<V, bool>::value, "std::vector<bool> does not keep its values in a contiguous array");
+public:
+	using values_t = std::vector<V>;
+	using table_t = separate_chaining_hash_table<K, values_t, Hasher>;
+	using iterator = typename table_t::iterator;
+	class range;
+
+	explicit contiguous_dictionary(std::size_t capacity = 101) : table_(capacity) {}
+
+	// number of values, whatever their keys
+	std::size_t size() const { return size_; }
+	bool empty() const { return size() == 0; }
+	std::size_t key_count() const { return table_.size(); }
+
+	void insert(K const& k, V const& v)
+	{
+		(*table_.find_or_put(k)).value_.push_back(v);
+		++size_;
+	}
+
+	range find_all(K const& k)
+	{
+		iterator it = table_.find(k);
+		if (it == table_.end()) return range(nullptr, nullptr);
+		values_t& values = (*it).value_;
+		return range(values.data(), values.data() + values.size());
+	}
+
+	std::size_t count(K const& k) { return find_all(k).size(); }
+
+	// erases every value of k
+	void erase_all(K const& k)
+	{
+		iterator it = table_.find(k);
+		if (it == table_.end()) throw std::runtime_error("no entry with this key");
+		size_ -= (*it).value_.size();
+		table_.erase(it);
+	}
+
+	// entries pair every key with the array of its values
+	iterator begin() { return table_.begin(); }
+	iterator end() { return table_.end(); }
+
+	class range
+	{
+	public:
+		range(V* begin, V* end) : begin_(begin), end_(end) {}
+
+		V* begin() const { return begin_; }
+		V* end() const { return end_; }
+		std::size_t size() const { return end_ - begin_; }
+		bool empty() const { return begin_ == end_; }
+		V& operator[](std::size_t i) const { return begin_[i]; }
+
+	private:
+		V* begin_;
+		V* end_;
+	};
+
+private:
+	table_t table_;
+	std::size_t size_{ 0 };
+};
+
+}
\ No newline at end of file
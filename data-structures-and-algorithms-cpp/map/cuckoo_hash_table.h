@@ -0,0 +1,357 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "utils/utils.h"
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+#include "hash_table_statistics.h"
+
+namespace data_structures_cpp {
+
+/*
+ * bucketized cuckoo hash table: every key may only live in one of two buckets of
+ * 4 slots, so a lookup reads at most two buckets whatever the keys or the load.
+ * The first bucket comes from the hash, the second from the first and an 8 bit tag of
+ * the hash, so an entry can be moved to its other bucket without hashing its key again.
+ * Tags are stored next to the entries and spare most key comparisons.
+ *
+ * When both buckets of a new key are full, a breadth first search looks for a short path
+ * of entries to move to their other bucket, which frees a slot for the new key.
+ * The table doubles when no such path exists, until its bucket mask is wide enough to
+ * separate keys that only share their low hash bits and tag. Loads of about 95% are reachable.
+ * Inserting only throws when the keys with the new key's full hash already fill both buckets.
+ * If Hasher defines is_transparent, lookups accept any type it can hash and compare against K.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class cuckoo_hash_table
+{
+public:
+	using entry_t = key_value_pair<K const, V>;
+	class iterator;
+
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	explicit cuckoo_hash_table(std::size_t capacity = 0) { initialize(normalize_bucket_count(capacity)); }
+
+	cuckoo_hash_table(cuckoo_hash_table const& rhs) = delete;
+	cuckoo_hash_table& operator=(cuckoo_hash_table const& rhs) = delete;
+
+	~cuckoo_hash_table() { destroy_buckets(); }
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size() == 0; }
+	std::size_t capacity() const { return bucket_count_ * slots_per_bucket; }
+
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k) { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k)
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k, precomputed_hash h)
+	{
+		std::size_t i = finder(k, h.value);
+		return i == npos ? end() : iterator(this, i);
+	}
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ hash(k) }; }
+
+	// starts loading both buckets of hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const
+	{
+		std::size_t b = home(h.value);
+		data_structures_cpp::prefetch(buckets_.get() + b);
+		data_structures_cpp::prefetch(buckets_.get() + alternate(b, tag(h.value)));
+	}
+
+	iterator put(K const& k, V const& v)
+	{
+		std::size_t h = hash(k);
+		std::size_t i = finder(k, h);
+		if (i != npos)
+		{
+			slot(i).value_ = v;
+			return iterator(this, i);
+		}
+		inserter(h, entry_t(k, v));
+		return iterator(this, finder(k, h));
+	}
+
+	template <class Q = K>
+	void erase(key_arg<Q> const& k)
+	{
+		std::size_t i = finder(k, hash(k));
+		if (i == npos) throw std::runtime_error("no entry with this key");
+		eraser(i);
+	}
+
+	void erase(iterator const& it) { eraser(it.i_); }
+
+	// make room for n entries without rehashing
+	void reserve(std::size_t n)
+	{
+		std::size_t count = normalize_bucket_count(n);
+		if (count > bucket_count_) rehash(count);
+	}
+
+	// a probe is one bucket, every entry is found after one or two
+	hash_table_statistics statistics() const
+	{
+		hash_table_statistics stats{};
+		stats.bucket_count = bucket_count_;
+		for (std::size_t b = 0; b < bucket_count_; ++b)
+		{
+			std::size_t n = 0;
+			for (std::size_t s = 0; s < slots_per_bucket; ++s)
+			{
+				if (!(buckets_[b].occupied_ & (1u << s))) continue;
+				stats.add_entry(home(hash(entry(buckets_[b], s).key_)) == b ? 1 : 2);
+				++n;
+			}
+			stats.add_bucket(n);
+		}
+		return stats.finish();
+	}
+
+	iterator begin() { return iterator(this, next_full(0)); }
+	iterator end() { return iterator(this, capacity()); }
+
+protected:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t slots_per_bucket = 4;
+	static constexpr std::size_t min_bucket_count = 2;
+	// bound on the buckets explored to find a cuckoo path, paths are at most 4 moves long
+	static constexpr std::size_t max_path_search = 256;
+
+	struct bucket_t
+	{
+		std::uint8_t occupied_;	// one bit per slot
+		std::uint8_t tags_[slots_per_bucket];
+		alignas(entry_t) unsigned char storage_[slots_per_bucket][sizeof(entry_t)];
+	};
+
+	// a bucket reached by the path search, with the slot of its parent whose entry would move into it
+	struct path_node
+	{
+		std::size_t bucket_;
+		std::size_t parent_;
+		std::size_t slot_;
+	};
+
+	template <class Q>
+	std::size_t hash(Q const& k) const { return table_hash(hasher_, k); }
+
+	static std::uint8_t tag(std::size_t h) { return static_cast<std::uint8_t>(h >> (sizeof(std::size_t) * 8 - 8)); }
+	std::size_t home(std::size_t h) const { return h & (bucket_count_ - 1); }
+	// an involution, the alternate of the alternate of b is b
+	std::size_t alternate(std::size_t b, std::uint8_t t) const { return (b ^ mix_hash(t + 1)) & (bucket_count_ - 1); }
+
+	static std::size_t normalize_bucket_count(std::size_t n)
+	{
+		std::size_t count = min_bucket_count;
+		while (count * slots_per_bucket - count * slots_per_bucket / 16 < n) count *= 2;
+		return count;
+	}
+
+	static entry_t& entry(bucket_t& b, std::size_t s) { return *std::launder(reinterpret_cast<entry_t*>(b.storage_[s])); }
+	static entry_t const& entry(bucket_t const& b, std::size_t s) { return *std::launder(reinterpret_cast<entry_t const*>(b.storage_[s])); }
+	entry_t& slot(std::size_t i) { return entry(buckets_[i / slots_per_bucket], i % slots_per_bucket); }
+	bool full(std::size_t i) const { return buckets_[i / slots_per_bucket].occupied_ & (1u << (i % slots_per_bucket)); }
+
+	static std::size_t free_slot(bucket_t const& b)
+	{
+		for (std::size_t s = 0; s < slots_per_bucket; ++s) if (!(b.occupied_ & (1u << s))) return s;
+		return npos;
+	}
+
+	static void place(bucket_t& b, std::size_t s, std::uint8_t t, entry_t&& e)
+	{
+		new (b.storage_[s]) entry_t(std::move(e));
+		b.tags_[s] = t;
+		b.occupied_ |= 1u << s;
+	}
+
+	// keys are const, entries are moved by reconstructing them in their new slot
+	static void move_entry(bucket_t& to, std::size_t to_slot, bucket_t& from, std::size_t from_slot)
+	{
+		place(to, to_slot, from.tags_[from_slot], std::move(entry(from, from_slot)));
+		entry(from, from_slot).~entry_t();
+		from.occupied_ &= ~(1u << from_slot);
+	}
+
+	template <class Q>
+	std::size_t search_bucket(std::size_t b, std::uint8_t t, Q const& k)
+	{
+		bucket_t& bucket = buckets_[b];
+		for (std::size_t s = 0; s < slots_per_bucket; ++s)
+		{
+			if ((bucket.occupied_ & (1u << s)) && bucket.tags_[s] == t && entry(bucket, s).key_ == k) return b * slots_per_bucket + s;
+		}
+		return npos;
+	}
+
+	template <class Q>
+	std::size_t finder(Q const& k, std::size_t h)
+	{
+		std::size_t b = home(h);
+		std::size_t i = search_bucket(b, tag(h), k);
+		return i != npos ? i : search_bucket(alternate(b, tag(h)), tag(h), k);
+	}
+
+	// e must not be in the table, the table is left untouched if it throws
+	void inserter(std::size_t h, entry_t&& e)
+	{
+		if (try_insert(h, e)) return;
+		if (saturated(h)) throw std::runtime_error("too many keys share the same hash");
+		// keys sharing only some bits of their hash end up in distinct buckets as the mask widens
+		do rehash(bucket_count_ * 2); while (!try_insert(h, e));
+	}
+
+	// whether the keys of full hash h fill every slot they may use at any bucket count,
+	// they always share their buckets so growing could not make room for one more
+	bool saturated(std::size_t h)
+	{
+		std::uint8_t t = tag(h);
+		std::size_t usable = mix_hash(t + 1) == 0 ? slots_per_bucket : 2 * slots_per_bucket;
+		std::size_t b = home(h);
+		std::size_t a = alternate(b, t);
+		return count_hash(b, h) + (a != b ? count_hash(a, h) : 0) >= usable;
+	}
+
+	std::size_t count_hash(std::size_t b, std::size_t h)
+	{
+		bucket_t& bucket = buckets_[b];
+		std::size_t n = 0;
+		for (std::size_t s = 0; s < slots_per_bucket; ++s)
+		{
+			if ((bucket.occupied_ & (1u << s)) && bucket.tags_[s] == tag(h) && hash(entry(bucket, s).key_) == h) ++n;
+		}
+		return n;
+	}
+
+	// places e in one of its buckets, moving other entries along a cuckoo path if needed.
+	// The table is left untouched when no path is found.
+	bool try_insert(std::size_t h, entry_t& e)
+	{
+		std::uint8_t t = tag(h);
+		path_node path[max_path_search];
+		std::size_t n = 0;
+		path[n++] = path_node{ home(h), npos, npos };
+		if (alternate(home(h), t) != home(h)) path[n++] = path_node{ alternate(home(h), t), npos, npos };
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			std::size_t s = free_slot(buckets_[path[i].bucket_]);
+			if (s != npos)
+			{
+				// shift the entries along the path, from the free slot back to a root bucket
+				std::size_t j = i;
+				for (; path[j].parent_ != npos; j = path[j].parent_)
+				{
+					move_entry(buckets_[path[j].bucket_], s, buckets_[path[path[j].parent_].bucket_], path[j].slot_);
+					s = path[j].slot_;
+				}
+				place(buckets_[path[j].bucket_], s, t, std::move(e));
+				++size_;
+				return true;
+			}
+			bucket_t const& bucket = buckets_[path[i].bucket_];
+			for (std::size_t slot = 0; slot < slots_per_bucket && n < max_path_search; ++slot)
+			{
+				std::size_t next = alternate(path[i].bucket_, bucket.tags_[slot]);
+				if (!on_path(path, i, next)) path[n++] = path_node{ next, i, slot };
+			}
+		}
+		return false;
+	}
+
+	// whether bucket b is already on the path leading to node i, moving through it twice would break the path
+	static bool on_path(path_node const* path, std::size_t i, std::size_t b)
+	{
+		for (; i != npos; i = path[i].parent_) if (path[i].bucket_ == b) return true;
+		return false;
+	}
+
+	void eraser(std::size_t i)
+	{
+		bucket_t& b = buckets_[i / slots_per_bucket];
+		entry(b, i % slots_per_bucket).~entry_t();
+		b.occupied_ &= ~(1u << (i % slots_per_bucket));
+		--size_;
+	}
+
+	// entries are moved into a larger table, then tables are swapped.
+	// Buckets of the larger table project onto those of this one, so the entries always
+	// fit: the larger table doubles again when its path search gives up, it never throws.
+	void rehash(std::size_t count)
+	{
+		cuckoo_hash_table larger(0);
+		larger.initialize(count);
+		for (std::size_t i = 0; i < capacity(); ++i)
+		{
+			if (!full(i)) continue;
+			std::size_t h = hash(slot(i).key_);
+			while (!larger.try_insert(h, slot(i))) larger.rehash(larger.bucket_count_ * 2);
+			eraser(i);
+		}
+		std::swap(buckets_, larger.buckets_);
+		std::swap(bucket_count_, larger.bucket_count_);
+		std::swap(size_, larger.size_);
+	}
+
+	void initialize(std::size_t count)
+	{
+		bucket_count_ = count;
+		buckets_.reset(new bucket_t[count]());
+		size_ = 0;
+	}
+
+	void destroy_buckets()
+	{
+		if (!buckets_) return;
+		for (std::size_t i = 0; i < capacity(); ++i) if (full(i)) slot(i).~entry_t();
+	}
+
+	std::size_t next_full(std::size_t i) const
+	{
+		while (i < capacity() && !full(i)) ++i;
+		return i;
+	}
+
+private:
+	std::unique_ptr<bucket_t[]> buckets_{};
+	std::size_t bucket_count_{ 0 };
+	std::size_t size_{ 0 };
+	Hasher hasher_{};
+
+public:
+	class iterator
+	{
+	private:
+		cuckoo_hash_table* table_;
+		std::size_t i_;
+	public:
+		iterator(cuckoo_hash_table* table, std::size_t i) : table_(table), i_(i) {}
+
+		entry_t& operator*() const { return table_->slot(i_); }
+		entry_t* operator->() const { return &table_->slot(i_); }
+		bool operator==(iterator const& rhs) const { return table_ == rhs.table_ && i_ == rhs.i_; }
+		bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+		iterator& operator++()
+		{
+			i_ = table_->next_full(i_ + 1);
+			return *this;
+		}
+
+		friend class cuckoo_hash_table<K, V, Hasher>;
+	};
+};
+
+}
\ No newline at end of file
@@ -6,20 +6,21 @@
 
 namespace data_structures_cpp {
 
-template <class K, class V, class Hasher>
+template <class K, class V, class Hasher = default_hash<K>>
 class dictionary : public separate_chaining_hash_table<K, V, Hasher>
 {
 public:
 	using iterator = typename separate_chaining_hash_table<K, V, Hasher>::iterator;
+	using entry_t = typename separate_chaining_hash_table<K, V, Hasher>::entry_t;
 	class range;
 
 	explicit dictionary(int capacity = 101) : separate_chaining_hash_table<K, V, Hasher>(capacity) {}
 	
 	range find_all(const K& k)
 	{
-		iterator begin = finder(k);
+		iterator begin = this->finder(k);
 		iterator end = begin;
-		while (!end_of_bucket(end) && (*begin).key_ == (*end).key_)
+		while (!this->end_of_bucket(end) && (*begin).key_ == (*end).key_)
 		{
 			++end;
 		}
@@ -28,8 +29,8 @@ public:
 	
 	iterator insert(const K& k, const V& v)
 	{
-		iterator it = finder(k);
-		return inserter(it, entry_t(k, v));
+		iterator it = this->finder(k);
+		return this->inserter(it, entry_t(k, v));
 	}
 
 	class range
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace data_structures_cpp {
+
+/*
+ * shape of a hash table, as returned by statistics(), to tell a poor hasher from a good one.
+ * A probe is what a lookup inspects before it can compare keys: a list node for
+ * separate_chaining_hash_table, a slot for robin_hood_hash_table, a group of control bytes
+ * for swiss_hash_table and a bucket for cuckoo_hash_table.
+ * With a good hasher, probe lengths stay short and collision_rate stays close to what
+ * uniformly random hashes give at the same load factor.
+ */
+struct hash_table_statistics
+{
+	std::size_t size{ 0 };
+	std::size_t bucket_count{ 0 };
+	// probe_length_histogram[p] entries are found after p + 1 probes
+	std::vector<std::size_t> probe_length_histogram{};
+	// bucket_size_histogram[n] buckets hold n entries, empty for tables whose buckets are single slots
+	std::vector<std::size_t> bucket_size_histogram{};
+	std::size_t max_probe_length{ 0 };
+	// fraction of the entries that are not found on the first probe
+	double collision_rate{ 0 };
+	double mean_probe_length{ 0 };
+
+	// accounts for an entry found after the given number of probes
+	void add_entry(std::size_t probes)
+	{
+		if (probe_length_histogram.size() < probes) probe_length_histogram.resize(probes);
+		++probe_length_histogram[probes - 1];
+		if (probes > max_probe_length) max_probe_length = probes;
+		++size;
+	}
+
+	void add_bucket(std::size_t entries)
+	{
+		if (bucket_size_histogram.size() <= entries) bucket_size_histogram.resize(entries + 1);
+		++bucket_size_histogram[entries];
+	}
+
+	// computes the rates once every entry has been added
+	hash_table_statistics& finish()
+	{
+		if (size == 0) return *this;
+		std::size_t total = 0;
+		for (std::size_t p = 0; p < probe_length_histogram.size(); ++p) total += (p + 1) * probe_length_histogram[p];
+		mean_probe_length = static_cast<double>(total) / size;
+		collision_rate = static_cast<double>(size - probe_length_histogram[0]) / size;
+		return *this;
+	}
+};
+
+}
\ No newline at end of file
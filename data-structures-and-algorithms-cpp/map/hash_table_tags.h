@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+namespace data_structures_cpp {
+
+/*
+ * how separate_chaining_hash_table grows its bucket array
+ */
+struct rehash_tags
+{
+	// the insertion crossing the load factor relinks every entry at once
+	struct immediate {};
+	// the old bucket array is kept and a few of its buckets are relinked by every
+	// subsequent operation, so no single operation pays for the whole table
+	struct incremental
+	{
+		static constexpr std::size_t buckets_per_step = 8;
+	};
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,345 @@
+#pragma once
+
+#include <new>
+#include <string>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+#include "hash_table_statistics.h"
+
+namespace data_structures_cpp {
+
+namespace detail {
+
+// first bytes of an image, written last so that an unfinished image never loads
+struct mapped_hash_table_header
+{
+	static constexpr std::uint64_t expected_magic = 0x31424154485344ull;	// "DSHTAB1", byte swapped on the other endianness
+	static constexpr std::uint32_t expected_version = 1;
+
+	std::uint64_t magic_;
+	std::uint32_t version_;
+	std::uint32_t key_size_;
+	std::uint32_t value_size_;
+	std::uint32_t slot_size_;
+	std::uint64_t size_;
+	std::uint64_t capacity_;
+	std::uint64_t slots_offset_;
+};
+
+// a read-only or read-write shared mapping of a whole file, unmapped on destruction
+class file_mapping
+{
+public:
+	explicit file_mapping() = default;
+
+	file_mapping(file_mapping&& rhs) noexcept : data_(rhs.data_), length_(rhs.length_)
+	{
+		rhs.data_ = nullptr;
+		rhs.length_ = 0;
+	}
+
+	file_mapping& operator=(file_mapping&& rhs) noexcept
+	{
+		std::swap(data_, rhs.data_);
+		std::swap(length_, rhs.length_);
+		return *this;
+	}
+
+	~file_mapping() { if (data_) munmap(data_, length_); }
+
+	// maps the whole file at path, creating it with the given length when writable
+	static file_mapping open(std::string const& path, bool writable, std::size_t length = 0)
+	{
+		int fd = writable ? ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) : ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) throw std::runtime_error("cannot open " + path);
+		struct stat info {};
+		if (writable ? ftruncate(fd, static_cast<off_t>(length)) != 0 : fstat(fd, &info) != 0)
+		{
+			close(fd);
+			throw std::runtime_error("cannot size " + path);
+		}
+		file_mapping mapping{};
+		mapping.length_ = writable ? length : static_cast<std::size_t>(info.st_size);
+		void* data = mapping.length_ == 0 ? nullptr
+			: mmap(nullptr, mapping.length_, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (data == MAP_FAILED) throw std::runtime_error("cannot map " + path);
+		mapping.data_ = static_cast<unsigned char*>(data);
+		return mapping;
+	}
+
+	unsigned char* data() const { return data_; }
+	std::size_t length() const { return length_; }
+
+	// writes dirty pages back to the file
+	void sync() const { sync(0, length_); }
+
+	// writes back the dirty pages holding bytes [offset, offset + length) of the file
+	void sync(std::size_t offset, std::size_t length) const
+	{
+		if (!data_ || length == 0) return;
+		std::size_t const page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		std::size_t const first = offset / page * page;
+		if (msync(data_ + first, offset + length - first, MS_SYNC) != 0) throw std::runtime_error("cannot write the mapped file");
+	}
+
+private:
+	unsigned char* data_{ nullptr };
+	std::size_t length_{ 0 };
+};
+
+}
+
+template <class K, class V, class Hasher> class mapped_hash_table_writer;
+
+/*
+ * read-only hash table served straight from a memory mapped file image, as written by
+ * mapped_hash_table_writer. The image holds no pointers: a header, one control byte per
+ * slot and the slots themselves, open addressed with linear probing. Loading maps the
+ * file and checks its header, nothing is read or deserialized until lookups touch it,
+ * so opening a table of any size takes constant time and pages are shared between
+ * processes mapping the same file.
+ * K and V must be trivially copyable, and Hasher must give the same hashes in the writing
+ * and the reading processes, which default_hash does. Images are only portable between
+ * builds agreeing on the layout of K and V, their sizes and the byte order are checked.
+ * Requires POSIX mmap.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class mapped_hash_table
+{
+	static_assert(std::is_trivially_copyable<K>::value && std::is_trivially_copyable<V>::value,
+		"mapped_hash_table entries are stored as raw bytes");
+
+public:
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	// throws if path does not hold a finished image of this key and value type
+	explicit mapped_hash_table(std::string const& path) : mapping_(detail::file_mapping::open(path, false))
+	{
+		using header_t = detail::mapped_hash_table_header;
+		if (mapping_.length() < sizeof(header_t)) throw std::runtime_error(path + " is not a hash table image");
+		header_t header{};
+		std::memcpy(&header, mapping_.data(), sizeof(header_t));
+		if (header.magic_ != header_t::expected_magic) throw std::runtime_error(path + " is not a finished hash table image");
+		if (header.version_ != header_t::expected_version || header.key_size_ != sizeof(K)
+			|| header.value_size_ != sizeof(V) || header.slot_size_ != sizeof(slot_t))
+		{
+			throw std::runtime_error(path + " holds another version or entry type");
+		}
+		if (header.capacity_ == 0 || (header.capacity_ & (header.capacity_ - 1)) != 0 || header.size_ >= header.capacity_
+			|| header.slots_offset_ != slots_offset(header.capacity_)
+			|| mapping_.length() != header.slots_offset_ + header.capacity_ * sizeof(slot_t))
+		{
+			throw std::runtime_error(path + " is truncated or corrupted");
+		}
+		size_ = header.size_;
+		capacity_ = header.capacity_;
+		controls_ = mapping_.data() + sizeof(header_t);
+		slots_ = reinterpret_cast<slot_t const*>(mapping_.data() + header.slots_offset_);
+	}
+
+	mapped_hash_table(mapped_hash_table const& rhs) = delete;
+	mapped_hash_table& operator=(mapped_hash_table const& rhs) = delete;
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size() == 0; }
+	std::size_t capacity() const { return capacity_; }
+
+	// value of key k, nullptr if k is missing. Points into the mapping, valid as long as the table
+	template <class Q = K>
+	V const* find(key_arg<Q> const& k) const { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k). Probing stops after capacity() slots, should a corrupted image have no empty one
+	template <class Q = K>
+	V const* find(key_arg<Q> const& k, precomputed_hash h) const
+	{
+		std::uint8_t c = control(h.value);
+		std::size_t i = h.value & (capacity_ - 1);
+		for (std::size_t probes = 0; probes < capacity_ && controls_[i] != empty_control; ++probes, i = (i + 1) & (capacity_ - 1))
+		{
+			if (controls_[i] == c && slots_[i].key_ == k) return &slots_[i].value_;
+		}
+		return nullptr;
+	}
+
+	template <class Q = K>
+	bool contains(key_arg<Q> const& k) const { return find<Q>(k) != nullptr; }
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ table_hash(hasher_, k) }; }
+
+	// starts loading the first control byte and slot of hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const
+	{
+		std::size_t i = h.value & (capacity_ - 1);
+		data_structures_cpp::prefetch(controls_ + i);
+		data_structures_cpp::prefetch(slots_ + i);
+	}
+
+	// a probe is one slot, reading it touches every page of the image
+	hash_table_statistics statistics() const
+	{
+		hash_table_statistics stats{};
+		stats.bucket_count = capacity_;
+		for (std::size_t i = 0; i < capacity_; ++i)
+		{
+			if (controls_[i] == empty_control) continue;
+			std::size_t home = table_hash(hasher_, slots_[i].key_) & (capacity_ - 1);
+			stats.add_entry(((i - home) & (capacity_ - 1)) + 1);
+		}
+		return stats.finish();
+	}
+
+	// calls f(key, value) for every entry, in slot order
+	template <class F>
+	void for_each(F f) const
+	{
+		for (std::size_t i = 0; i < capacity_; ++i) if (controls_[i] != empty_control) f(slots_[i].key_, slots_[i].value_);
+	}
+
+protected:
+	struct slot_t
+	{
+		K key_;
+		V value_;
+	};
+
+	static constexpr std::uint8_t empty_control = 0;
+
+	// 7 high bits of the hash, with the high bit set to tell full slots from empty ones
+	static std::uint8_t control(std::size_t h) { return static_cast<std::uint8_t>(0x80 | (h >> (sizeof(std::size_t) * 8 - 7))); }
+
+	// slots follow the control bytes, aligned to a cache line
+	static std::size_t slots_offset(std::size_t capacity)
+	{
+		std::size_t offset = sizeof(detail::mapped_hash_table_header) + capacity;
+		std::size_t alignment = alignof(slot_t) > 64 ? alignof(slot_t) : 64;
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	// smallest power of two capacity keeping n entries under 3/4 load, so every probe meets an empty slot
+	static std::size_t normalize_capacity(std::size_t n)
+	{
+		std::size_t capacity = 8;
+		while (capacity - capacity / 4 <= n) capacity *= 2;
+		return capacity;
+	}
+
+private:
+	detail::file_mapping mapping_;
+	std::size_t size_{ 0 };
+	std::size_t capacity_{ 0 };
+	std::uint8_t const* controls_{ nullptr };
+	slot_t const* slots_{ nullptr };
+	Hasher hasher_{};
+
+	friend class mapped_hash_table_writer<K, V, Hasher>;
+};
+
+/*
+ * builds the image of a mapped_hash_table in place in a memory mapped file sized for
+ * the expected number of entries, so that images larger than memory can be written.
+ * The image only becomes loadable once finish() wrote its header: a crash or an
+ * exception while writing leaves a file that mapped_hash_table refuses to load.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class mapped_hash_table_writer
+{
+public:
+	using table_t = mapped_hash_table<K, V, Hasher>;
+	using slot_t = typename table_t::slot_t;
+
+	// creates or truncates path, to hold at most max_size distinct keys
+	mapped_hash_table_writer(std::string const& path, std::size_t max_size)
+		: capacity_(table_t::normalize_capacity(max_size)), max_size_(max_size),
+		mapping_(detail::file_mapping::open(path, true, table_t::slots_offset(capacity_) + capacity_ * sizeof(slot_t)))
+	{
+		// the file is created sparse and reads as zeros, every control byte starts empty
+		controls_ = mapping_.data() + sizeof(detail::mapped_hash_table_header);
+		slots_ = reinterpret_cast<slot_t*>(mapping_.data() + table_t::slots_offset(capacity_));
+	}
+
+	mapped_hash_table_writer(mapped_hash_table_writer const& rhs) = delete;
+	mapped_hash_table_writer& operator=(mapped_hash_table_writer const& rhs) = delete;
+
+	std::size_t size() const { return size_; }
+	std::size_t capacity() const { return capacity_; }
+
+	// inserts or overwrites the value of k, throws once more than max_size distinct keys were put
+	void put(K const& k, V const& v)
+	{
+		if (finished_) throw std::runtime_error("the image is already finished");
+		std::size_t h = table_hash(hasher_, k);
+		std::uint8_t c = table_t::control(h);
+		std::size_t i = h & (capacity_ - 1);
+		for (; controls_[i] != table_t::empty_control; i = (i + 1) & (capacity_ - 1))
+		{
+			if (controls_[i] == c && slots_[i].key_ == k)
+			{
+				slots_[i].value_ = v;
+				return;
+			}
+		}
+		if (size_ == max_size_) throw std::runtime_error("more keys than the image was sized for");
+		new (slots_ + i) slot_t{ k, v };
+		controls_[i] = c;
+		++size_;
+	}
+
+	/*
+	 * flushes the control bytes and slots to disk, then writes and flushes the header,
+	 * so that the header never reaches the disk ahead of the entries it validates.
+	 * The image can be loaded afterwards.
+	 */
+	void finish()
+	{
+		if (finished_) return;
+		detail::mapped_hash_table_header header{};
+		header.magic_ = detail::mapped_hash_table_header::expected_magic;
+		header.version_ = detail::mapped_hash_table_header::expected_version;
+		header.key_size_ = sizeof(K);
+		header.value_size_ = sizeof(V);
+		header.slot_size_ = sizeof(slot_t);
+		header.size_ = size_;
+		header.capacity_ = capacity_;
+		header.slots_offset_ = table_t::slots_offset(capacity_);
+		mapping_.sync();
+		std::memcpy(mapping_.data(), &header, sizeof(header));
+		mapping_.sync(0, sizeof(header));
+		finished_ = true;
+	}
+
+private:
+	std::size_t capacity_;
+	std::size_t max_size_;
+	detail::file_mapping mapping_;
+	std::uint8_t* controls_{ nullptr };
+	slot_t* slots_{ nullptr };
+	std::size_t size_{ 0 };
+	bool finished_{ false };
+	Hasher hasher_{};
+};
+
+// writes the entries of table, any table iterating over key_value_pair, as an image at path
+template <class K, class V, class Hasher = default_hash<K>, class Table>
+void save_mapped_hash_table(std::string const& path, Table& table)
+{
+	mapped_hash_table_writer<K, V, Hasher> writer(path, table.size());
+	for (auto it = table.begin(); it != table.end(); ++it) writer.put((*it).key(), (*it).value());
+	writer.finish();
+}
+
+}
\ No newline at end of file
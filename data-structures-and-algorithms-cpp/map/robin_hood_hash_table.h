@@ -0,0 +1,263 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "utils/utils.h"
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+#include "hash_table_statistics.h"
+
+namespace data_structures_cpp {
+
+/*
+ * open addressing hash table using linear probing with Robin Hood insertion:
+ * an entry being inserted takes the slot of any entry closer to its home slot,
+ * which keeps probe distances short and similar. Every slot stores its entry inline
+ * together with the entry's distance from its home slot, so a lookup can stop as soon as
+ * it reaches a slot whose entry is closer to home than the key would be. Misses thus
+ * cost about as much as hits instead of running to the next empty slot.
+ * Erasing shifts the following displaced entries one slot back, no tombstones are left.
+ * The capacity is a power of two and the load factor is kept under 7/8.
+ * If Hasher defines is_transparent, lookups accept any type it can hash and compare against K.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class robin_hood_hash_table
+{
+public:
+	using entry_t = key_value_pair<K const, V>;
+	class iterator;
+
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	explicit robin_hood_hash_table(std::size_t capacity = 0) { initialize(normalize_capacity(capacity)); }
+
+	robin_hood_hash_table(robin_hood_hash_table const& rhs) = delete;
+	robin_hood_hash_table& operator=(robin_hood_hash_table const& rhs) = delete;
+
+	~robin_hood_hash_table() { destroy_slots(); }
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size() == 0; }
+	std::size_t capacity() const { return capacity_; }
+
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k) { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k)
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k, precomputed_hash h)
+	{
+		std::size_t i = finder(k, h.value);
+		return i == npos ? end() : iterator(this, i);
+	}
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ hash(k) }; }
+
+	// starts loading the home slot of hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const { data_structures_cpp::prefetch(slots_.get() + (h.value & (capacity_ - 1))); }
+
+	iterator put(K const& k, V const& v)
+	{
+		std::size_t h = hash(k);
+		std::size_t i = finder(k, h);
+		if (i != npos)
+		{
+			slot(i).value_ = v;
+			return iterator(this, i);
+		}
+		if (size_ + 1 > max_size(capacity_)) rehash(capacity_ * 2);
+		return iterator(this, inserter(h, entry_t(k, v)));
+	}
+
+	template <class Q = K>
+	void erase(key_arg<Q> const& k)
+	{
+		std::size_t i = finder(k, hash(k));
+		if (i == npos) throw std::runtime_error("no entry with this key");
+		eraser(i);
+	}
+
+	void erase(iterator const& it) { eraser(it.i_); }
+
+	// make room for n entries without rehashing
+	void reserve(std::size_t n)
+	{
+		std::size_t capacity = normalize_capacity(n);
+		if (capacity > capacity_) rehash(capacity);
+	}
+
+	// a probe is one slot
+	hash_table_statistics statistics() const
+	{
+		hash_table_statistics stats{};
+		stats.bucket_count = capacity_;
+		for (std::size_t i = 0; i < capacity_; ++i) if (full(i)) stats.add_entry(slots_[i].distance_);
+		return stats.finish();
+	}
+
+	iterator begin() { return iterator(this, next_full(0)); }
+	iterator end() { return iterator(this, capacity_); }
+
+protected:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t min_capacity = 8;
+
+	// distance_ is 1 + the distance of the entry from its home slot, 0 for an empty slot
+	struct slot_t
+	{
+		std::uint32_t distance_;
+		alignas(entry_t) unsigned char storage_[sizeof(entry_t)];
+	};
+
+	template <class Q>
+	std::size_t hash(Q const& k) const { return table_hash(hasher_, k); }
+
+	static std::size_t max_size(std::size_t capacity) { return capacity - capacity / 8; }
+
+	static std::size_t normalize_capacity(std::size_t n)
+	{
+		std::size_t capacity = min_capacity;
+		while (max_size(capacity) < n) capacity *= 2;
+		return capacity;
+	}
+
+	static entry_t& entry(slot_t& s) { return *std::launder(reinterpret_cast<entry_t*>(s.storage_)); }
+	entry_t& slot(std::size_t i) { return entry(slots_[i]); }
+	bool full(std::size_t i) const { return slots_[i].distance_ != 0; }
+
+	// keys are const, entries are moved by reconstructing them in their new slot
+	static void move_entry(slot_t& to, slot_t& from)
+	{
+		new (to.storage_) entry_t(std::move(entry(from)));
+		entry(from).~entry_t();
+		to.distance_ = from.distance_;
+	}
+
+	template <class Q>
+	std::size_t finder(Q const& k, std::size_t h)
+	{
+		std::size_t mask = capacity_ - 1;
+		std::size_t i = h & mask;
+		// an empty slot or an entry closer to its home than k would be ends the search
+		for (std::uint32_t distance = 1; slots_[i].distance_ >= distance; ++distance)
+		{
+			if (slots_[i].distance_ == distance && slot(i).key_ == k) return i;
+			i = (i + 1) & mask;
+		}
+		return npos;
+	}
+
+	// e must not be in the table and there must be a free slot, returns the slot of e
+	std::size_t inserter(std::size_t h, entry_t&& e)
+	{
+		std::size_t mask = capacity_ - 1;
+		std::size_t i = h & mask;
+		std::size_t result = npos;
+		slot_t carried;	// entry still looking for a slot
+		new (carried.storage_) entry_t(std::move(e));
+		carried.distance_ = 1;
+		for (;; i = (i + 1) & mask, ++carried.distance_)
+		{
+			if (!full(i))
+			{
+				move_entry(slots_[i], carried);
+				++size_;
+				return result == npos ? i : result;
+			}
+			if (slots_[i].distance_ < carried.distance_)
+			{
+				// take from the rich: the resident entry moves on in place of the carried one
+				slot_t resident;
+				move_entry(resident, slots_[i]);
+				move_entry(slots_[i], carried);
+				move_entry(carried, resident);
+				if (result == npos) result = i;
+			}
+		}
+	}
+
+	// backward shift: pull every following displaced entry one slot closer to home
+	void eraser(std::size_t i)
+	{
+		std::size_t mask = capacity_ - 1;
+		slot(i).~entry_t();
+		for (std::size_t next = (i + 1) & mask; slots_[next].distance_ > 1; i = next, next = (next + 1) & mask)
+		{
+			move_entry(slots_[i], slots_[next]);
+			--slots_[i].distance_;
+		}
+		slots_[i].distance_ = 0;
+		--size_;
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		std::unique_ptr<slot_t[]> old_slots = std::move(slots_);
+		std::size_t old_capacity = capacity_;
+		initialize(capacity);
+		for (std::size_t j = 0; j < old_capacity; ++j)
+		{
+			if (old_slots[j].distance_ == 0) continue;
+			entry_t& e = entry(old_slots[j]);
+			inserter(hash(e.key_), std::move(e));
+			e.~entry_t();
+		}
+	}
+
+	void initialize(std::size_t capacity)
+	{
+		capacity_ = capacity;
+		slots_.reset(new slot_t[capacity]());
+		size_ = 0;
+	}
+
+	void destroy_slots()
+	{
+		if (!slots_) return;
+		for (std::size_t i = 0; i < capacity_; ++i) if (full(i)) slot(i).~entry_t();
+	}
+
+	std::size_t next_full(std::size_t i) const
+	{
+		while (i < capacity_ && !full(i)) ++i;
+		return i;
+	}
+
+private:
+	std::unique_ptr<slot_t[]> slots_{};
+	std::size_t capacity_{ 0 };
+	std::size_t size_{ 0 };
+	Hasher hasher_{};
+
+public:
+	class iterator
+	{
+	private:
+		robin_hood_hash_table* table_;
+		std::size_t i_;
+	public:
+		iterator(robin_hood_hash_table* table, std::size_t i) : table_(table), i_(i) {}
+
+		entry_t& operator*() const { return table_->slot(i_); }
+		entry_t* operator->() const { return &table_->slot(i_); }
+		bool operator==(iterator const& rhs) const { return table_ == rhs.table_ && i_ == rhs.i_; }
+		bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+		iterator& operator++()
+		{
+			i_ = table_->next_full(i_ + 1);
+			return *this;
+		}
+
+		friend class robin_hood_hash_table<K, V, Hasher>;
+	};
+};
+
+}
\ No newline at end of file
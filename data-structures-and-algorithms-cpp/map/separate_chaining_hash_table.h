@@ -2,16 +2,44 @@
 
 #include <vector>
 #include <list>
+#include <cmath>
+#include <algorithm>
 #include <cstddef>
-#include <exception>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 #include "utils/utils.h"
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+#include "hash_table_statistics.h"
+#include "hash_table_tags.h"
+#include "set/blocked_bloom_filter.h"
 
 namespace data_structures_cpp {
 
-template <class K, class V, class Hasher> class separate_chaining_hash_table;
-
-template <class K, class V, class Hasher>
+/*
+ * hash table whose buckets are linked lists of entries.
+ * The bucket count is a power of two and hashes are mixed before being masked.
+ * When an insertion would push load_factor() over max_load_factor() the bucket count
+ * doubles, existing list nodes are relinked into the new buckets rather than reallocated.
+ * Rehashing invalidates iterators.
+ *
+ * With rehash_tags::incremental the old bucket array is kept after growing and every
+ * find, put and erase first relinks the next few of its buckets. Until it is drained, a key
+ * lives in the old array if its old bucket has not been migrated yet and in the new one
+ * otherwise, so each operation still looks in a single bucket. Since any of these
+ * operations may move entries, they invalidate iterators while a migration is under way.
+ *
+ * With enable_filter, lookups first test a blocked_bloom_filter of the keys and skip
+ * the bucket when the key is surely absent. The filter is rebuilt whenever the table
+ * outgrows it; erased keys stay in it until then and only cost false positives.
+ *
+ * If Hasher defines is_transparent, lookups accept any type it can hash and compare
+ * against K, e.g. a std::string_view for std::string keys.
+ */
+template <class K, class V, class Hasher = default_hash<K>, class Rehash = rehash_tags::immediate>
 class separate_chaining_hash_table
 {
 public:
@@ -22,12 +50,65 @@ public:
 	using entry_iterator_t = typename bucket_t::iterator;
 	class iterator;
 
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	// capacity is the initial number of buckets, rounded up to a power of two
 	explicit separate_chaining_hash_table(std::size_t capacity = 101)
-		: size_(0), b_array_(capacity)
+		: size_(0), b_array_(normalize_bucket_count(capacity))
 	{}
 
 	std::size_t size() const { return size_; }
 	bool empty() const { return size() == 0; }
+	bool rehashing() const { return !old_array_.empty(); }
+
+	std::size_t bucket_count() const { return b_array_.size(); }
+	float load_factor() const { return static_cast<float>(size_) / bucket_count(); }
+	float max_load_factor() const { return max_load_factor_; }
+
+	void max_load_factor(float f)
+	{
+		if (!(f > 0)) throw std::runtime_error("max load factor must be positive");
+		max_load_factor_ = f;
+		if (load_factor() > max_load_factor_) rehash(0);
+	}
+
+	// bucket count becomes at least n and large enough to respect max_load_factor()
+	void rehash(std::size_t n)
+	{
+		std::size_t count = normalize_bucket_count(std::max(n, min_bucket_count(size_)));
+		if (count != bucket_count()) relink(count);
+	}
+
+	// make room for n entries without rehashing
+	void reserve(std::size_t n) { rehash(min_bucket_count(n)); }
+
+	// tests a Bloom filter of the keys before walking a bucket, worth it when most lookups miss
+	void enable_filter(double false_positive_rate = 0.01)
+	{
+		filter_.emplace(std::max(2 * size_, bucket_count()), false_positive_rate);
+		for (std::size_t i = migrated_; i < old_array_.size(); ++i) fill_filter(old_array_[i]);
+		for (bucket_t const& bucket : b_array_) fill_filter(bucket);
+	}
+
+	void disable_filter() { filter_.reset(); }
+	bool filtered() const { return filter_.has_value(); }
+
+	// a probe is one list node, bucket sizes are chain lengths
+	hash_table_statistics statistics() const
+	{
+		hash_table_statistics stats{};
+		stats.bucket_count = bucket_count();
+		auto add = [&stats](bucket_t const& bucket)
+		{
+			std::size_t n = 0;
+			for (auto it = bucket.begin(); it != bucket.end(); ++it) stats.add_entry(++n);
+			stats.add_bucket(n);
+		};
+		for (std::size_t i = migrated_; i < old_array_.size(); ++i) add(old_array_[i]);
+		for (bucket_t const& bucket : b_array_) add(bucket);
+		return stats.finish();
+	}
 
 	iterator find(K const& k, V const& v)
 	{
@@ -36,6 +117,23 @@ public:
 		else return it;
 	}
 
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k) { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k)
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k, precomputed_hash h)
+	{
+		iterator it = finder(k, h.value);
+		return end_of_bucket(it) ? end() : it;
+	}
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ table_hash(hash, k) }; }
+
+	// starts loading the bucket of hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const { data_structures_cpp::prefetch(&bucket_of(h.value)); }
+
 	iterator put(K const& k, V const& v)
 	{
 		iterator it = finder(k);
@@ -47,7 +145,50 @@ public:
 		}
 	}
 
-	void erase(K const& k)
+	// entry of k, k is put with value v first if it is absent
+	iterator find_or_put(K const& k, V const& v = V())
+	{
+		iterator it = finder(k);
+		if (end_of_bucket(it)) return inserter(it, entry_t(k, v));
+		return it;
+	}
+
+	/*
+	 * out[i] becomes find(keys[i]). Keys are hashed up front, then the bucket of each
+	 * key and the first entry of its chain are prefetched a few lookups ahead of it,
+	 * so the cache misses of independent lookups overlap instead of adding up.
+	 * A migration under way takes a single step before the batch and none during it,
+	 * so every iterator of out stays valid until the table is modified.
+	 */
+	void find_batch(std::vector<K> const& keys, std::vector<iterator>& out)
+	{
+		if constexpr (std::is_same<Rehash, rehash_tags::incremental>::value) migrate(Rehash::buckets_per_step);
+		std::vector<std::size_t> hashes = hash_batch(keys, [](K const& k) -> K const& { return k; });
+		out.clear();
+		out.reserve(keys.size());
+		for (std::size_t i = 0; i < keys.size(); ++i)
+		{
+			prefetch_ahead(hashes, i);
+			iterator it = locate(keys[i], hashes[i]);
+			out.push_back(end_of_bucket(it) ? end() : it);
+		}
+	}
+
+	// put of every entry in order, prefetching like find_batch
+	void put_batch(std::vector<entry_t> const& entries)
+	{
+		std::vector<std::size_t> hashes = hash_batch(entries, [](entry_t const& e) -> K const& { return e.key_; });
+		for (std::size_t i = 0; i < entries.size(); ++i)
+		{
+			prefetch_ahead(hashes, i);
+			iterator it = finder(entries[i].key_, hashes[i]);
+			if (end_of_bucket(it)) inserter(it, entries[i]);
+			else it.entry_it_->value_ = entries[i].value_;
+		}
+	}
+
+	template <class Q = K>
+	void erase(key_arg<Q> const& k)
 	{
 		iterator it = finder(k);
 		if (end_of_bucket(it)) throw std::runtime_error("no entry with this key");
@@ -59,26 +200,104 @@ public:
 	iterator begin()
 	{
 		if (empty()) return end();
-		bucket_iterator_t bucket_it = b_array_.begin();
-		while (bucket_it->empty()) ++bucket_it;
-		return iterator(b_array_, bucket_it, bucket_it->begin());
+		iterator it = rehashing()
+			? iterator(old_array_, old_array_.begin() + migrated_, entry_iterator_t(), &b_array_)
+			: iterator(b_array_, b_array_.begin());
+		it.skip_empty_buckets();
+		return it;
 	}
 	iterator end() { return iterator(b_array_, b_array_.end()); }
 protected:
-	iterator finder(K const& k)
+	std::size_t bucket_index(K const& k) const { return table_hash(hash, k) & (b_array_.size() - 1); }
+
+	template <class Q>
+	iterator finder(Q const& k) { return finder(k, table_hash(hash, k)); }
+
+	template <class Q>
+	iterator finder(Q const& k, std::size_t h)
 	{
-		int i = hash(k) % b_array_.size();
-		bucket_iterator_t bucket_it = b_array_.begin() + i;
-		iterator it(b_array_, bucket_it, bucket_it->begin());
+		if constexpr (std::is_same<Rehash, rehash_tags::incremental>::value) migrate(Rehash::buckets_per_step);
+		return locate(k, h);
+	}
+
+	// finder without the migration step, moves nothing
+	template <class Q>
+	iterator locate(Q const& k, std::size_t h)
+	{
+		if (rehashing() && (h & (old_array_.size() - 1)) >= migrated_)
+		{
+			return scan(old_array_, h & (old_array_.size() - 1), k, h, &b_array_);
+		}
+		return scan(b_array_, h & (b_array_.size() - 1), k, h);
+	}
+
+	// a key the filter rules out is reported at the end of its bucket, where put inserts it
+	template <class Q>
+	iterator scan(bucket_array_t& a, std::size_t i, Q const& k, std::size_t h, bucket_array_t* next = nullptr)
+	{
+		bucket_iterator_t bucket_it = a.begin() + i;
+		if (filter_ && !filter_->contains(precomputed_hash{ h })) return iterator(a, bucket_it, bucket_it->end(), next);
+		iterator it(a, bucket_it, bucket_it->begin(), next);
 		while (!end_of_bucket(it) && (*it).key_ != k) next_entry(it);
 		return it;
 	}
 
-	iterator inserter(iterator const& it, entry_t const& e)
+	// bucket holding the keys of hash h, without migrating anything
+	bucket_t const& bucket_of(std::size_t h) const
+	{
+		if (rehashing() && (h & (old_array_.size() - 1)) >= migrated_) return old_array_[h & (old_array_.size() - 1)];
+		return b_array_[h & (b_array_.size() - 1)];
+	}
+
+	// hashes of the keys of a batch, the buckets of the first lookups are prefetched right away
+	template <class T, class Key>
+	std::vector<std::size_t> hash_batch(std::vector<T> const& batch, Key key) const
 	{
-		entry_iterator_t entry_it = it.bucket_it_->insert(it.entry_it_, e);
+		std::vector<std::size_t> hashes(batch.size());
+		for (std::size_t i = 0; i < batch.size(); ++i)
+		{
+			hashes[i] = table_hash(hash, key(batch[i]));
+			if (i < bucket_prefetch_distance) data_structures_cpp::prefetch(&bucket_of(hashes[i]));
+		}
+		return hashes;
+	}
+
+	// the bucket of lookup i + bucket_prefetch_distance is requested first, by the time
+	// lookup i + entry_prefetch_distance comes its bucket is cached and tells where its chain starts
+	void prefetch_ahead(std::vector<std::size_t> const& hashes, std::size_t i) const
+	{
+		if (i + bucket_prefetch_distance < hashes.size())
+		{
+			data_structures_cpp::prefetch(&bucket_of(hashes[i + bucket_prefetch_distance]));
+		}
+		if (i + entry_prefetch_distance < hashes.size())
+		{
+			bucket_t const& bucket = bucket_of(hashes[i + entry_prefetch_distance]);
+			if (!bucket.empty()) data_structures_cpp::prefetch(&bucket.front());
+		}
+	}
+
+	// inserts e before it, it is looked up again if the table has to grow first
+	iterator inserter(iterator it, entry_t const& e)
+	{
+		if (size_ + 1 > max_load_factor_ * bucket_count())
+		{
+			grow(Rehash{});
+			it = finder(e.key_);
+		}
+		it.entry_it_ = it.bucket_it_->insert(it.entry_it_, e);
 		++size_;
-		return iterator(b_array_, it.bucket_it_, entry_it);
+		if (filter_)
+		{
+			if (size_ > filter_->capacity()) enable_filter(filter_->false_positive_rate());
+			else filter_->insert(precomputed_hash{ table_hash(hash, e.key_) });
+		}
+		return it;
+	}
+
+	void fill_filter(bucket_t const& bucket)
+	{
+		for (entry_t const& e : bucket) filter_->insert(precomputed_hash{ table_hash(hash, e.key_) });
 	}
 
 	void eraser(iterator const& it)
@@ -87,6 +306,60 @@ protected:
 		--size_;
 	}
 
+	void grow(rehash_tags::immediate) { relink(bucket_count() * 2); }
+
+	void grow(rehash_tags::incremental)
+	{
+		migrate(old_array_.size());
+		old_array_.swap(b_array_);
+		b_array_ = bucket_array_t(old_array_.size() * 2);
+	}
+
+	// relinks the next buckets of the old array, frees it once it is drained
+	void migrate(std::size_t buckets)
+	{
+		for (; buckets > 0 && rehashing(); --buckets)
+		{
+			relink_bucket(old_array_[migrated_]);
+			if (++migrated_ == old_array_.size())
+			{
+				bucket_array_t().swap(old_array_);
+				migrated_ = 0;
+			}
+		}
+	}
+
+	// moves every list node into a new bucket array of the given size
+	void relink(std::size_t count)
+	{
+		migrate(old_array_.size());
+		bucket_array_t old_array(count);
+		old_array.swap(b_array_);
+		for (bucket_t& bucket : old_array) relink_bucket(bucket);
+	}
+
+	// entries of a bucket keep their relative order so equal keys stay adjacent
+	void relink_bucket(bucket_t& bucket)
+	{
+		while (!bucket.empty())
+		{
+			bucket_t& target = b_array_[bucket_index(bucket.front().key_)];
+			target.splice(target.end(), bucket, bucket.begin());
+		}
+	}
+
+	static std::size_t normalize_bucket_count(std::size_t n)
+	{
+		std::size_t count = 1;
+		while (count < n) count *= 2;
+		return count;
+	}
+
+	std::size_t min_bucket_count(std::size_t n) const
+	{
+		return static_cast<std::size_t>(std::ceil(n / max_load_factor_));
+	}
+
 	static void next_entry(iterator& it) { ++it.entry_it_; }
 	static bool end_of_bucket(iterator const& it) 
 	{ 
@@ -94,9 +367,16 @@ protected:
 	}
 		
 private:
+	static constexpr std::size_t bucket_prefetch_distance = 16;
+	static constexpr std::size_t entry_prefetch_distance = 8;
+
 	std::size_t size_;
+	float max_load_factor_{ 1.0f };
 	Hasher hash;
 	bucket_array_t b_array_;
+	bucket_array_t old_array_{};
+	std::size_t migrated_{ 0 };
+	std::optional<blocked_bloom_filter<K, Hasher>> filter_{};
 
 public:
 	class iterator
@@ -105,9 +385,24 @@ public:
 		entry_iterator_t entry_it_;
 		bucket_iterator_t bucket_it_;
 		bucket_array_t const * bucket_array_;
+		bucket_array_t* next_array_;	// bucket array to continue with once bucket_array_ is exhausted
+
+		void skip_empty_buckets()
+		{
+			for (;;)
+			{
+				while (bucket_it_ != bucket_array_->end() && bucket_it_->empty()) ++bucket_it_;
+				if (bucket_it_ != bucket_array_->end() || !next_array_) break;
+				bucket_array_ = next_array_;
+				bucket_it_ = next_array_->begin();
+				next_array_ = nullptr;
+			}
+			if (bucket_it_ != bucket_array_->end()) entry_it_ = bucket_it_->begin();
+		}
 	public:
-		iterator(bucket_array_t const& a, bucket_iterator_t const& b, entry_iterator_t const& e = entry_iterator_t())
-			: entry_it_(e), bucket_it_(b), bucket_array_(&a)
+		iterator(bucket_array_t const& a, bucket_iterator_t const& b, entry_iterator_t const& e = entry_iterator_t(),
+			bucket_array_t* next = nullptr)
+			: entry_it_(e), bucket_it_(b), bucket_array_(&a), next_array_(next)
 		{}
 
 		entry_t& operator*() const { return *entry_it_; }
@@ -126,14 +421,12 @@ public:
 			if (end_of_bucket(*this))
 			{
 				++bucket_it_;
-				while (bucket_it_ != bucket_array_->end() && bucket_it_->empty()) ++bucket_it_;
-				if (bucket_it_ == bucket_array_->end()) return *this;
-				entry_it_ = bucket_it_->begin();
+				skip_empty_buckets();
 			}
 			return *this;
 		}
 
-		friend class separate_chaining_hash_table<K,V,Hasher>;
+		friend class separate_chaining_hash_table<K,V,Hasher,Rehash>;
 	};
 };
 
@@ -0,0 +1,254 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "utils/utils.h"
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+
+namespace data_structures_cpp {
+
+namespace detail {
+
+// the builtin is a library call unless the target has a popcount instruction
+inline std::size_t popcount(std::uint64_t x)
+{
+#if defined(__POPCNT__)
+	return static_cast<std::size_t>(__builtin_popcountll(x));
+#else
+	x = x - ((x >> 1) & 0x5555555555555555ull);
+	x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+	x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+	return static_cast<std::size_t>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// calls f(begin, end, thread) on threads contiguous chunks of [0, n), each on its own thread
+template <class F>
+void parallel_chunks(std::size_t n, std::size_t threads, F f)
+{
+	if (threads <= 1)
+	{
+		f(std::size_t(0), n, std::size_t(0));
+		return;
+	}
+	std::vector<std::thread> workers{};
+	for (std::size_t t = 0; t < threads; ++t) workers.emplace_back(f, n * t / threads, n * (t + 1) / threads, t);
+	for (auto& worker : workers) worker.join();
+}
+
+}
+
+/*
+ * immutable map over a key set known up front, indexed by a minimal perfect hash built
+ * as in BBHash (Limasset et al.): keys are hashed into a bit array of one bit per key,
+ * keys landing alone on their bit set it and keep that position, colliding keys are
+ * hashed again into the next, smaller, level. The index of a key is the number of bits
+ * set before its own, so the entries fill an array of exactly size() slots.
+ * The levels take about 3 bits per key plus 1/8 bit per level bit for the rank samples.
+ * A lookup reads about 1.6 bitmap words on average and a single entry, whose key is
+ * compared to tell keys outside the set apart.
+ * Levels are built with the given number of threads, hashing chunks of the keys
+ * concurrently into shared atomic bit arrays. Keys still colliding after the last level,
+ * in practice only keys sharing their whole hash, are stored last and searched linearly.
+ * If Hasher defines is_transparent, lookups accept any type it can hash and compare against K.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class static_perfect_hash_map
+{
+public:
+	using entry_t = key_value_pair<K, V>;
+	using iterator = typename std::vector<entry_t>::const_iterator;
+
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	explicit static_perfect_hash_map() = default;
+
+	// throws if two entries share a key. threads == 0 uses every hardware thread
+	explicit static_perfect_hash_map(std::vector<entry_t> entries, std::size_t threads = 0)
+	{
+		if (threads == 0) threads = std::thread::hardware_concurrency();
+		if (threads == 0 || entries.size() < parallel_threshold) threads = 1;
+		std::vector<std::uint64_t> hashes(entries.size());
+		detail::parallel_chunks(entries.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t)
+		{
+			for (std::size_t i = begin; i < end; ++i) hashes[i] = table_hash(hasher_, entries[i].key_);
+		});
+		build_levels(hashes, threads);
+		place(entries, threads);
+	}
+
+	std::size_t size() const { return entries_.size(); }
+	bool empty() const { return size() == 0; }
+
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k) const { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k)
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k, precomputed_hash h) const
+	{
+		std::size_t i = index(h.value);
+		if (i != npos) return entries_[i].key_ == k ? begin() + i : end();
+		for (i = size() - fallback_.size(); i < size(); ++i)
+		{
+			if (fallback_[i - (size() - fallback_.size())] == h.value && entries_[i].key_ == k) return begin() + i;
+		}
+		return end();
+	}
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ table_hash(hasher_, k) }; }
+
+	// starts loading the first level word of hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const
+	{
+		if (!levels_.empty()) data_structures_cpp::prefetch(bits_.data() + position(h.value, 0, levels_[0].size_) / 64);
+	}
+
+	iterator begin() const { return entries_.begin(); }
+	iterator end() const { return entries_.end(); }
+
+	// memory taken by the perfect hash itself, levels and rank samples, not counting the entries
+	double bits_per_key() const
+	{
+		return empty() ? 0 : static_cast<double>((bits_.size() + ranks_.size()) * 64) / size();
+	}
+
+	std::size_t level_count() const { return levels_.size(); }
+
+protected:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+	static constexpr std::size_t max_levels = 32;
+	static constexpr std::size_t words_per_rank = 8;
+	// below this many keys, starting threads costs more than it saves
+	static constexpr std::size_t parallel_threshold = 1 << 16;
+
+	// a level occupies size_ bits of bits_ from bit offset_, both multiples of 64
+	struct level_t
+	{
+		std::size_t offset_;
+		std::size_t size_;
+	};
+
+	// position of hash h in a level of n bits, an independent hash per level
+	static std::size_t position(std::uint64_t h, std::size_t level, std::size_t n)
+	{
+		std::uint64_t x = fmix64(h ^ ((level + 1) * 0x9e3779b97f4a7c15ull));
+		if (n <= (std::uint64_t(1) << 32)) return static_cast<std::size_t>(((x >> 32) * n) >> 32);
+		return static_cast<std::size_t>(x % n);
+	}
+
+	bool test(std::size_t bit) const { return bits_[bit / 64] >> (bit % 64) & 1; }
+
+	// bits set before bit
+	std::size_t rank(std::size_t bit) const
+	{
+		std::size_t word = bit / 64;
+		std::size_t r = ranks_[word / words_per_rank];
+		for (std::size_t w = word - word % words_per_rank; w < word; ++w) r += detail::popcount(bits_[w]);
+		return r + detail::popcount(bits_[word] & ((std::uint64_t(1) << (bit % 64)) - 1));
+	}
+
+	// index of the entry of hash h, npos if h falls through every level
+	std::size_t index(std::uint64_t h) const
+	{
+		for (std::size_t l = 0; l < levels_.size(); ++l)
+		{
+			std::size_t bit = levels_[l].offset_ + position(h, l, levels_[l].size_);
+			if (test(bit)) return rank(bit);
+		}
+		return npos;
+	}
+
+	void build_levels(std::vector<std::uint64_t>& hashes, std::size_t threads)
+	{
+		for (std::size_t l = 0; l < max_levels && !hashes.empty(); ++l)
+		{
+			std::size_t n = (hashes.size() + 63) / 64 * 64;
+			std::vector<std::atomic<std::uint64_t>> seen(n / 64), collided(n / 64);
+			detail::parallel_chunks(hashes.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					std::size_t p = position(hashes[i], l, n);
+					std::uint64_t bit = std::uint64_t(1) << (p % 64);
+					if (seen[p / 64].fetch_or(bit, std::memory_order_relaxed) & bit) collided[p / 64].fetch_or(bit, std::memory_order_relaxed);
+				}
+			});
+			levels_.push_back(level_t{ bits_.size() * 64, n });
+			for (std::size_t w = 0; w < n / 64; ++w) bits_.push_back(seen[w].load(std::memory_order_relaxed) & ~collided[w].load(std::memory_order_relaxed));
+
+			// colliding hashes move on to the next level
+			std::vector<std::vector<std::uint64_t>> remaining(threads);
+			detail::parallel_chunks(hashes.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t t)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					std::size_t p = position(hashes[i], l, n);
+					if (collided[p / 64].load(std::memory_order_relaxed) >> (p % 64) & 1) remaining[t].push_back(hashes[i]);
+				}
+			});
+			hashes.clear();
+			for (auto& part : remaining) hashes.insert(hashes.end(), part.begin(), part.end());
+		}
+		ranks_.resize(bits_.size() / words_per_rank + 1);
+		for (std::size_t w = 0, r = 0; w < bits_.size(); ++w)
+		{
+			if (w % words_per_rank == 0) ranks_[w / words_per_rank] = r;
+			r += detail::popcount(bits_[w]);
+		}
+	}
+
+	// stores entries in the order of their index, entries left over by the levels go last
+	void place(std::vector<entry_t>& entries, std::size_t threads)
+	{
+		std::vector<std::size_t> order(entries.size(), npos);
+		std::vector<std::vector<std::size_t>> left_over(threads);
+		detail::parallel_chunks(entries.size(), threads, [&](std::size_t begin, std::size_t end, std::size_t t)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				std::size_t j = index(table_hash(hasher_, entries[i].key_));
+				if (j == npos) left_over[t].push_back(i);
+				else order[j] = i;
+			}
+		});
+		std::size_t next = entries.size();
+		for (auto const& part : left_over) next -= part.size();
+		for (auto const& part : left_over)
+		{
+			for (std::size_t i : part)
+			{
+				std::uint64_t h = table_hash(hasher_, entries[i].key_);
+				for (std::size_t j = 0; j < fallback_.size(); ++j)
+				{
+					if (fallback_[j] == h && entries[order[next + j]].key_ == entries[i].key_) throw std::runtime_error("duplicate key");
+				}
+				fallback_.push_back(h);
+				order[next + fallback_.size() - 1] = i;
+			}
+		}
+		entries_.reserve(entries.size());
+		for (std::size_t i : order) entries_.push_back(std::move(entries[i]));
+	}
+
+private:
+	std::vector<entry_t> entries_{};
+	std::vector<level_t> levels_{};
+	std::vector<std::uint64_t> bits_{};
+	// bits set in bits_ before every words_per_rank words
+	std::vector<std::uint64_t> ranks_{};
+	// hashes of the last entries, which no level could tell apart, searched linearly
+	std::vector<std::uint64_t> fallback_{};
+	Hasher hasher_{};
+};
+
+}
\ No newline at end of file
@@ -0,0 +1,390 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DATA_STRUCTURES_CPP_SWISS_SSE2
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#include "utils/utils.h"
+#include "utils/hash.h"
+#include "utils/prefetch.h"
+#include "hash_table_statistics.h"
+
+namespace data_structures_cpp {
+namespace detail {
+
+/*
+ * control bytes of swiss_hash_table: a full slot stores the low 7 bits of its hash,
+ * empty and deleted slots have their high bit set
+ */
+enum ctrl_t : std::int8_t
+{
+	ctrl_empty = -128,	// 0b10000000
+	ctrl_deleted = -2	// 0b11111110
+};
+
+inline std::size_t count_trailing_zeros(std::uint64_t x)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return index;
+#else
+	return __builtin_ctzll(x);
+#endif
+}
+
+/*
+ * set of slots within a group, one bit per slot spaced 2^Shift bits apart
+ */
+template <std::size_t Shift>
+class group_bitmask
+{
+public:
+	explicit group_bitmask(std::uint64_t mask) : mask_(mask) {}
+	explicit operator bool() const { return mask_ != 0; }
+	std::size_t lowest() const { return count_trailing_zeros(mask_) >> Shift; }
+	void pop_lowest() { mask_ &= mask_ - 1; }
+private:
+	std::uint64_t mask_;
+};
+
+#if defined(DATA_STRUCTURES_CPP_SWISS_SSE2)
+
+// 16 control bytes compared at once with SSE2
+class ctrl_group
+{
+public:
+	static constexpr std::size_t width = 16;
+	using bitmask_t = group_bitmask<0>;
+
+	explicit ctrl_group(std::int8_t const* ctrl) : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl))) {}
+
+	bitmask_t match(std::int8_t h2) const
+	{
+		return bitmask_t(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+	}
+	bitmask_t match_empty() const
+	{
+		return bitmask_t(static_cast<std::uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ctrl_empty), ctrl_))));
+	}
+	bitmask_t match_empty_or_deleted() const
+	{
+		return bitmask_t(static_cast<std::uint16_t>(_mm_movemask_epi8(ctrl_)));
+	}
+private:
+	__m128i ctrl_;
+};
+
+#else
+
+// 8 control bytes compared at once within a 64 bit word, assumes little endian
+class ctrl_group
+{
+public:
+	static constexpr std::size_t width = 8;
+	using bitmask_t = group_bitmask<3>;
+
+	explicit ctrl_group(std::int8_t const* ctrl) { std::memcpy(&ctrl_, ctrl, sizeof(ctrl_)); }
+
+	// may report false positives next to a true match, keys are compared anyway
+	bitmask_t match(std::int8_t h2) const
+	{
+		std::uint64_t x = ctrl_ ^ (lsbs * static_cast<std::uint8_t>(h2));
+		return bitmask_t((x - lsbs) & ~x & msbs);
+	}
+	bitmask_t match_empty() const { return bitmask_t(ctrl_ & (~ctrl_ << 6) & msbs); }
+	bitmask_t match_empty_or_deleted() const { return bitmask_t(ctrl_ & msbs); }
+private:
+	static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+	static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+	std::uint64_t ctrl_;
+};
+
+#endif
+
+}
+
+/*
+ * open addressing hash table in the style of abseil's swiss tables.
+ * Besides the slots, the table keeps one control byte per slot holding 7 bits of the
+ * slot's hash. Lookups probe whole groups of control bytes with a single SIMD compare and
+ * only touch the slots whose hash bits match, so most misses never read a slot at all.
+ * Groups are probed quadratically, the capacity is a power of two and the load factor
+ * is kept under 7/8. Erased slots become tombstones until the next rehash.
+ * If Hasher defines is_transparent, lookups accept any type it can hash and compare against K.
+ */
+template <class K, class V, class Hasher = default_hash<K>>
+class swiss_hash_table
+{
+public:
+	using entry_t = key_value_pair<K const, V>;
+	class iterator;
+
+	template <class Q>
+	using key_arg = typename detail::key_arg<detail::is_transparent<Hasher>::value>::template type<K, Q>;
+
+	explicit swiss_hash_table(std::size_t capacity = 0) { initialize(normalize_capacity(capacity)); }
+
+	swiss_hash_table(swiss_hash_table const& rhs) = delete;
+	swiss_hash_table& operator=(swiss_hash_table const& rhs) = delete;
+
+	~swiss_hash_table() { destroy_slots(); }
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size() == 0; }
+	std::size_t capacity() const { return capacity_; }
+
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k) { return find(k, hash_of<Q>(k)); }
+
+	// h must be hash_of(k)
+	template <class Q = K>
+	iterator find(key_arg<Q> const& k, precomputed_hash h)
+	{
+		std::size_t i = finder(k, h.value);
+		return i == npos ? end() : iterator(this, i);
+	}
+
+	template <class Q = K>
+	precomputed_hash hash_of(key_arg<Q> const& k) const { return precomputed_hash{ hash(k) }; }
+
+	// starts loading the control bytes and first slot probed for hash h, to be called some time before find(k, h)
+	void prefetch(precomputed_hash h) const
+	{
+		std::size_t offset = h1(h.value) & (capacity_ - 1);
+		data_structures_cpp::prefetch(ctrl_.get() + offset);
+		data_structures_cpp::prefetch(slots_.get() + offset);
+	}
+
+	iterator put(K const& k, V const& v)
+	{
+		std::size_t h = hash(k);
+		std::size_t i = finder(k, h);
+		if (i != npos)
+		{
+			slot(i).value_ = v;
+			return iterator(this, i);
+		}
+		return iterator(this, inserter(h, k, v));
+	}
+
+	template <class Q = K>
+	void erase(key_arg<Q> const& k)
+	{
+		std::size_t i = finder(k, hash(k));
+		if (i == npos) throw std::runtime_error("no entry with this key");
+		eraser(i);
+	}
+
+	void erase(iterator const& it) { eraser(it.i_); }
+
+	// make room for n entries without rehashing
+	void reserve(std::size_t n)
+	{
+		std::size_t capacity = normalize_capacity(n + n / 7);
+		if (capacity > capacity_) rehash(capacity);
+	}
+
+	// a probe is one group of control bytes
+	hash_table_statistics statistics() const
+	{
+		hash_table_statistics stats{};
+		stats.bucket_count = capacity_;
+		for (std::size_t i = 0; i < capacity_; ++i) if (full(i)) stats.add_entry(probe_length(i));
+		return stats.finish();
+	}
+
+	iterator begin() { return iterator(this, next_full(0)); }
+	iterator end() { return iterator(this, capacity_); }
+
+protected:
+	using group_t = detail::ctrl_group;
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	struct slot_t
+	{
+		alignas(entry_t) unsigned char storage_[sizeof(entry_t)];
+	};
+
+	// mixed so that h1 and h2 are independent
+	template <class Q>
+	std::size_t hash(Q const& k) const { return table_hash(hasher_, k); }
+	static std::size_t h1(std::size_t h) { return h >> 7; }
+	static std::int8_t h2(std::size_t h) { return static_cast<std::int8_t>(h & 0x7f); }
+
+	static std::size_t normalize_capacity(std::size_t n)
+	{
+		std::size_t capacity = group_t::width;
+		while (capacity - capacity / 8 < n) capacity *= 2;
+		return capacity;
+	}
+
+	entry_t& slot(std::size_t i) { return *std::launder(reinterpret_cast<entry_t*>(slots_[i].storage_)); }
+	entry_t const& slot(std::size_t i) const { return *std::launder(reinterpret_cast<entry_t const*>(slots_[i].storage_)); }
+	bool full(std::size_t i) const { return ctrl_[i] >= 0; }
+
+	// the first group_t::width control bytes are mirrored after the last one,
+	// so a group can be loaded at any slot without wrapping around
+	void set_ctrl(std::size_t i, std::int8_t c)
+	{
+		ctrl_[i] = c;
+		if (i < group_t::width) ctrl_[capacity_ + i] = c;
+	}
+
+	template <class Q>
+	std::size_t finder(Q const& k, std::size_t h)
+	{
+		std::size_t mask = capacity_ - 1;
+		std::size_t offset = h1(h) & mask;
+		for (std::size_t step = group_t::width; ; step += group_t::width)
+		{
+			group_t group(ctrl_.get() + offset);
+			for (auto match = group.match(h2(h)); match; match.pop_lowest())
+			{
+				std::size_t i = (offset + match.lowest()) & mask;
+				if (slot(i).key_ == k) return i;
+			}
+			// an empty slot ends every probe sequence that could have reached k
+			if (group.match_empty()) return npos;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	// number of groups a lookup of the entry in slot i loads
+	std::size_t probe_length(std::size_t i) const
+	{
+		std::size_t mask = capacity_ - 1;
+		std::size_t offset = h1(hash(slot(i).key_)) & mask;
+		std::size_t probes = 1;
+		for (std::size_t step = group_t::width; ((i - offset) & mask) >= group_t::width; step += group_t::width, ++probes)
+		{
+			offset = (offset + step) & mask;
+		}
+		return probes;
+	}
+
+	// first empty or deleted slot on the probe sequence of h
+	std::size_t find_free(std::size_t h) const
+	{
+		std::size_t mask = capacity_ - 1;
+		std::size_t offset = h1(h) & mask;
+		for (std::size_t step = group_t::width; ; step += group_t::width)
+		{
+			auto free = group_t(ctrl_.get() + offset).match_empty_or_deleted();
+			if (free) return (offset + free.lowest()) & mask;
+			offset = (offset + step) & mask;
+		}
+	}
+
+	std::size_t inserter(std::size_t h, K const& k, V const& v)
+	{
+		std::size_t i = find_free(h);
+		if (growth_left_ == 0 && ctrl_[i] != detail::ctrl_deleted)
+		{
+			// purge tombstones if they are what fills the table, grow otherwise
+			rehash(size_ < (capacity_ - capacity_ / 8) / 2 ? capacity_ : capacity_ * 2);
+			i = find_free(h);
+		}
+		if (ctrl_[i] == detail::ctrl_empty) --growth_left_;
+		new (slots_[i].storage_) entry_t(k, v);
+		set_ctrl(i, h2(h));
+		++size_;
+		return i;
+	}
+
+	void eraser(std::size_t i)
+	{
+		slot(i).~entry_t();
+		set_ctrl(i, detail::ctrl_deleted);
+		--size_;
+	}
+
+	void rehash(std::size_t capacity)
+	{
+		std::unique_ptr<std::int8_t[]> old_ctrl = std::move(ctrl_);
+		std::unique_ptr<slot_t[]> old_slots = std::move(slots_);
+		std::size_t old_capacity = capacity_;
+		std::size_t size = size_;
+		initialize(capacity);
+		for (std::size_t j = 0; j < old_capacity; ++j)
+		{
+			if (old_ctrl[j] < 0) continue;
+			entry_t& e = *std::launder(reinterpret_cast<entry_t*>(old_slots[j].storage_));
+			std::size_t h = hash(e.key_);
+			std::size_t i = find_free(h);
+			new (slots_[i].storage_) entry_t(std::move(e));
+			set_ctrl(i, h2(h));
+			e.~entry_t();
+		}
+		size_ = size;
+		growth_left_ -= size;
+	}
+
+	void initialize(std::size_t capacity)
+	{
+		capacity_ = capacity;
+		ctrl_.reset(new std::int8_t[capacity + group_t::width]);
+		std::memset(ctrl_.get(), detail::ctrl_empty, capacity + group_t::width);
+		slots_.reset(new slot_t[capacity]);
+		size_ = 0;
+		growth_left_ = capacity - capacity / 8;
+	}
+
+	void destroy_slots()
+	{
+		if (!ctrl_) return;
+		for (std::size_t i = 0; i < capacity_; ++i) if (full(i)) slot(i).~entry_t();
+	}
+
+	std::size_t next_full(std::size_t i) const
+	{
+		while (i < capacity_ && !full(i)) ++i;
+		return i;
+	}
+
+private:
+	std::unique_ptr<std::int8_t[]> ctrl_{};
+	std::unique_ptr<slot_t[]> slots_{};
+	std::size_t capacity_{ 0 };
+	std::size_t size_{ 0 };
+	std::size_t growth_left_{ 0 };
+	Hasher hasher_{};
+
+public:
+	class iterator
+	{
+	private:
+		swiss_hash_table* table_;
+		std::size_t i_;
+	public:
+		iterator(swiss_hash_table* table, std::size_t i) : table_(table), i_(i) {}
+
+		entry_t& operator*() const { return table_->slot(i_); }
+		entry_t* operator->() const { return &table_->slot(i_); }
+		bool operator==(iterator const& rhs) const { return table_ == rhs.table_ && i_ == rhs.i_; }
+		bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+		iterator& operator++()
+		{
+			i_ = table_->next_full(i_ + 1);
+			return *this;
+		}
+
+		friend class swiss_hash_table<K, V, Hasher>;
+	};
+};
+
+}
\ No newline at end of file
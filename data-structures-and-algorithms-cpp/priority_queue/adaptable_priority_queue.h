@@ -1,54 +1,197 @@
 #pragma once
 
+#include <vector>
+#include <utility>
 #include <cstddef>
-
-#include "list_priority_queue.h"
+#include <stdexcept>
+#include <functional>
 
 namespace data_structures_cpp {
 
-template <typename T, typename TComparator> class adaptable_priority_queue;
+template <typename T, typename TComparator, std::size_t Arity> class adaptable_priority_queue;
+
+namespace detail {
 
+// heap of an adaptable_priority_queue, with the heap slot of every handle
+template <typename T>
+struct indexed_heap
+{
+	struct entry_t
+	{
+		T value_;
+		std::size_t handle_;
+	};
+
+	std::vector<entry_t> entries_{};
+	std::vector<std::size_t> slots_{};	// slots_[handle] is the index of its entry in entries_
+	std::vector<std::size_t> free_handles_{};
+};
+
+}
+
+/*
+ * handle of an element of an adaptable_priority_queue, valid until that element is
+ * popped or removed
+ */
 template <typename T>
 class position
 {
 public:
-	T const& operator*() { return *p; }
+	T const& operator*() const { return heap_->entries_[heap_->slots_[handle_]].value_; }
+	bool operator==(position const& rhs) const { return heap_ == rhs.heap_ && handle_ == rhs.handle_; }
+	bool operator!=(position const& rhs) const { return !(*this == rhs); }
+
 	// too many friends but oh well
-	template <class U, class V> friend class adaptable_priority_queue;
+	template <class U, class V, std::size_t A> friend class adaptable_priority_queue;
 private:
-	typename list_priority_queue_traits<T>::list_t::iterator p_;
+	position(detail::indexed_heap<T> const* heap, std::size_t handle) : heap_(heap), handle_(handle) {}
+
+	detail::indexed_heap<T> const* heap_;
+	std::size_t handle_;
 };
 
-template <typename T, typename TComparator = std::less<T>>
-class adaptable_priority_queue : protected list_priority_queue<T, TComparator>
+/*
+ * d-ary heap whose elements can be reached through the position returned when inserting
+ * them. Every entry carries a handle, and a table maps handles back to heap slots; it is
+ * updated whenever sifting moves an entry. insert, pop, remove, replace and decrease_key
+ * are O(log n). Handles of popped or removed elements are reused.
+ * Positions point into the queue, which can therefore be neither copied nor moved.
+ */
+template <typename T, typename TComparator = std::less<T>, std::size_t Arity = 2>
+class adaptable_priority_queue
 {
+	static_assert(Arity >= 2, "a heap needs at least two children per node");
+
 public:
-	std::size_t size() const { return list_priority_queue<T, TComparator>::size(); }
-	bool empty() const { return list_priority_queue<T, TComparator>::empty(); }
-	const T& front() const { return list_priority_queue<T, TComparator>::front(); }
+	using entry_t = typename detail::indexed_heap<T>::entry_t;
+
+	explicit adaptable_priority_queue() = default;
+	adaptable_priority_queue(adaptable_priority_queue const& rhs) = delete;
+	adaptable_priority_queue& operator=(adaptable_priority_queue const& rhs) = delete;
+
+	std::size_t size() const { return heap_.entries_.size(); }
+	bool empty() const { return size() == 0; }
+	const T& front() const { return heap_.entries_.front().value_; }
 
-	position<T> insert(T const& value) 
-	{ 
-		position<T> pos{};
-		/*pos.p_ = list_.insert(
-			std::upper_bound(list_.cbegin(), list_.cend(), value, comp_),
-			value
-		);*/
-		auto it = list_.begin();
-		while (it != list_.end() && comp_(*it, value)) ++it;
-		pos.p_ = list_.insert(it, value);
-		return pos;
+	position<T> insert(T const& value) { return emplace(value); }
+	position<T> insert(T&& value) { return emplace(std::move(value)); }
+
+	template <typename... Args>
+	position<T> emplace(Args&&... args)
+	{
+		std::size_t handle = acquire_handle();
+		heap_.entries_.push_back(entry_t{ T(std::forward<Args>(args)...), handle });
+		heap_.slots_[handle] = size() - 1;
+		sift_up(size() - 1);
+		return position<T>(&heap_, handle);
 	}
 
-	void pop() { return list_priority_queue<T, TComparator>::pop(); }
+	void pop() { remove_at(0); }
 
-	void remove(position<T> const& p) { this->list_.erase(p.p_); }
+	// moves the front element out and pops it
+	T pop_value()
+	{
+		T value = std::move(heap_.entries_.front().value_);
+		remove_at(0);
+		return value;
+	}
+
+	void remove(position<T> const& p) { remove_at(heap_.slots_[p.handle_]); }
+
+	// p keeps designating the element, now holding value
+	position<T> replace(position<T> const& p, T const& value) { return update(p, T(value)); }
+	position<T> replace(position<T> const& p, T&& value) { return update(p, std::move(value)); }
 
-	position<T> replace(position<T> const& p, T const& value) 
+	// like replace, for a value that is not ordered after the current one, only sifts up
+	void decrease_key(position<T> const& p, T const& value)
 	{
-		this->list_.erase(p.p_);
-		return insert(value);
+		std::size_t i = heap_.slots_[p.handle_];
+		if (comp_(heap_.entries_[i].value_, value)) throw std::runtime_error("the new value is ordered after the current one");
+		heap_.entries_[i].value_ = value;
+		sift_up(i);
 	}
+
+protected:
+	std::size_t acquire_handle()
+	{
+		if (heap_.free_handles_.empty())
+		{
+			heap_.slots_.push_back(0);
+			return heap_.slots_.size() - 1;
+		}
+		std::size_t handle = heap_.free_handles_.back();
+		heap_.free_handles_.pop_back();
+		return handle;
+	}
+
+	// moves e into slot i and records where its handle now lives
+	void place(std::size_t i, entry_t&& e)
+	{
+		heap_.entries_[i] = std::move(e);
+		heap_.slots_[heap_.entries_[i].handle_] = i;
+	}
+
+	position<T> update(position<T> const& p, T&& value)
+	{
+		std::size_t i = heap_.slots_[p.handle_];
+		heap_.entries_[i].value_ = std::move(value);
+		restore(i);
+		return p;
+	}
+
+	// the last entry fills the hole, then goes up or down
+	void remove_at(std::size_t i)
+	{
+		heap_.free_handles_.push_back(heap_.entries_[i].handle_);
+		if (i + 1 < size())
+		{
+			place(i, std::move(heap_.entries_.back()));
+			heap_.entries_.pop_back();
+			restore(i);
+		}
+		else heap_.entries_.pop_back();
+	}
+
+	void restore(std::size_t i)
+	{
+		if (i > 0 && comp_(heap_.entries_[i].value_, heap_.entries_[(i - 1) / Arity].value_)) sift_up(i);
+		else sift_down(i);
+	}
+
+	void sift_up(std::size_t i)
+	{
+		entry_t e = std::move(heap_.entries_[i]);
+		while (i > 0)
+		{
+			std::size_t parent = (i - 1) / Arity;
+			if (!comp_(e.value_, heap_.entries_[parent].value_)) break;
+			place(i, std::move(heap_.entries_[parent]));
+			i = parent;
+		}
+		place(i, std::move(e));
+	}
+
+	void sift_down(std::size_t i)
+	{
+		entry_t e = std::move(heap_.entries_[i]);
+		std::size_t n = size();
+		for (;;)
+		{
+			std::size_t first = Arity * i + 1;
+			if (first >= n) break;
+			std::size_t last = first + Arity < n ? first + Arity : n;
+			std::size_t best = first;
+			for (std::size_t c = first + 1; c < last; ++c) best = comp_(heap_.entries_[c].value_, heap_.entries_[best].value_) ? c : best;
+			if (!comp_(heap_.entries_[best].value_, e.value_)) break;
+			place(i, std::move(heap_.entries_[best]));
+			i = best;
+		}
+		place(i, std::move(e));
+	}
+
+private:
+	detail::indexed_heap<T> heap_{};
+	TComparator comp_;
 };
 
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <list>
+#include <utility>
 #include <algorithm>
 #include <cstddef>
 
@@ -13,20 +14,38 @@ public:
 	std::size_t size() const { return list_.size();  }
 	bool empty() const { return list_.empty(); }
 	
-	void push(const T& value)
+	void push(const T& value) { list_.insert(position_of(value), value); }
+
+	void push(T&& value) { list_.insert(position_of(value), std::move(value)); }
+
+	// builds the element in a list node of its own, then links that node in place
+	template <typename... Args>
+	void emplace(Args&&... args)
 	{
-		/*list_.insert(
-			std::upper_bound(list_.cbegin(), list_.cend(), value, comp_),
-			value
-		);*/
-		auto it = list_.begin();
-		while (it != list_.end() && comp_(*it, value)) ++it;
-		list_.insert(it, value);
+		std::list<T> node{};
+		node.emplace_back(std::forward<Args>(args)...);
+		list_.splice(position_of(node.front()), node);
 	}
 
 	const T& front() const { return list_.front(); }
 	void pop() { list_.pop_front(); }
+
+	// moves the front element out and pops it
+	T pop_value()
+	{
+		T value = std::move(list_.front());
+		list_.pop_front();
+		return value;
+	}
 protected:
+	// first element not ordered before value
+	typename std::list<T>::iterator position_of(T const& value)
+	{
+		auto it = list_.begin();
+		while (it != list_.end() && comp_(*it, value)) ++it;
+		return it;
+	}
+
 	std::list<T> list_;
 	TComparator comp_;
 };
@@ -0,0 +1,410 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+#include <cstddef>
+#include <stdexcept>
+#include <functional>
+#include <type_traits>
+
+namespace data_structures_cpp {
+
+namespace detail {
+
+/*
+ * storage for nodes, carved out of chunks that double in size and kept until the pool
+ * is destroyed. Released nodes go on a free list and are handed out again first.
+ * The chunks and free list of another pool can be spliced in O(1); a chunk it was still
+ * filling goes on a list of partly filled chunks, carved before any new chunk is added.
+ */
+template <typename Node>
+class node_pool
+{
+public:
+	explicit node_pool() = default;
+	node_pool(node_pool const& rhs) = delete;
+	node_pool& operator=(node_pool const& rhs) = delete;
+
+	node_pool(node_pool&& rhs) noexcept { swap(rhs); }
+	node_pool& operator=(node_pool&& rhs) noexcept
+	{
+		swap(rhs);
+		return *this;
+	}
+
+	~node_pool()
+	{
+		while (chunks_)
+		{
+			chunk_t* next = chunks_->next_;
+			std::allocator<slot_t>().deallocate(chunks_->slots_, chunks_->capacity_);
+			delete chunks_;
+			chunks_ = next;
+		}
+	}
+
+	// uninitialized storage for one node
+	void* allocate()
+	{
+		if (free_)
+		{
+			slot_t* s = free_;
+			free_ = s->next_;
+			if (!free_) free_tail_ = nullptr;
+			return s->storage_;
+		}
+		if (!chunks_ || chunks_->used_ == chunks_->capacity_)
+		{
+			if (partial_)
+			{
+				chunk_t* c = partial_;
+				void* p = c->slots_[c->used_++].storage_;
+				if (c->used_ == c->capacity_)
+				{
+					partial_ = c->next_partial_;
+					if (!partial_) partial_tail_ = nullptr;
+				}
+				return p;
+			}
+			add_chunk();
+		}
+		return chunks_->slots_[chunks_->used_++].storage_;
+	}
+
+	// number of nodes the pool holds storage for
+	std::size_t capacity() const { return capacity_; }
+
+	// p must come from allocate, the node in it already destroyed
+	void deallocate(void* p)
+	{
+		slot_t* s = static_cast<slot_t*>(p);
+		s->next_ = free_;
+		if (!free_) free_tail_ = s;
+		free_ = s;
+	}
+
+	// takes over the chunks and free list of rhs, leaving it empty
+	void splice(node_pool& rhs)
+	{
+		if (rhs.chunks_)
+		{
+			// the chunk rhs was filling keeps its unused slots for later allocations
+			chunk_t* filling = rhs.chunks_;
+			if (chunks_ && filling->used_ < filling->capacity_) rhs.push_partial(filling);
+			// our first chunk stays first, it is the one being filled
+			if (!chunks_)
+			{
+				chunks_ = rhs.chunks_;
+				chunks_tail_ = rhs.chunks_tail_;
+			}
+			else
+			{
+				rhs.chunks_tail_->next_ = chunks_->next_;
+				if (chunks_tail_ == chunks_) chunks_tail_ = rhs.chunks_tail_;
+				chunks_->next_ = rhs.chunks_;
+			}
+			capacity_ += rhs.capacity_;
+		}
+		if (rhs.partial_)
+		{
+			if (partial_tail_) partial_tail_->next_partial_ = rhs.partial_;
+			else partial_ = rhs.partial_;
+			partial_tail_ = rhs.partial_tail_;
+		}
+		if (rhs.free_)
+		{
+			rhs.free_tail_->next_ = free_;
+			if (!free_) free_tail_ = rhs.free_tail_;
+			free_ = rhs.free_;
+		}
+		rhs.chunks_ = rhs.chunks_tail_ = nullptr;
+		rhs.free_ = rhs.free_tail_ = nullptr;
+		rhs.partial_ = rhs.partial_tail_ = nullptr;
+		rhs.capacity_ = 0;
+	}
+
+	void swap(node_pool& rhs) noexcept
+	{
+		std::swap(chunks_, rhs.chunks_);
+		std::swap(chunks_tail_, rhs.chunks_tail_);
+		std::swap(free_, rhs.free_);
+		std::swap(free_tail_, rhs.free_tail_);
+		std::swap(partial_, rhs.partial_);
+		std::swap(partial_tail_, rhs.partial_tail_);
+		std::swap(capacity_, rhs.capacity_);
+	}
+
+protected:
+	static constexpr std::size_t min_chunk = 16;
+	static constexpr std::size_t max_chunk = 1 << 16;
+
+	union slot_t
+	{
+		slot_t* next_;
+		alignas(Node) unsigned char storage_[sizeof(Node)];
+	};
+
+	struct chunk_t
+	{
+		chunk_t* next_;
+		slot_t* slots_;
+		std::size_t capacity_;
+		std::size_t used_;
+		chunk_t* next_partial_;
+	};
+
+	void add_chunk()
+	{
+		std::size_t n = capacity_ < min_chunk ? min_chunk : capacity_ > max_chunk ? max_chunk : capacity_;
+		slot_t* slots = std::allocator<slot_t>().allocate(n);
+		chunks_ = new chunk_t{ chunks_, slots, n, 0, nullptr };
+		if (!chunks_tail_) chunks_tail_ = chunks_;
+		capacity_ += n;
+	}
+
+	void push_partial(chunk_t* c)
+	{
+		c->next_partial_ = nullptr;
+		if (partial_tail_) partial_tail_->next_partial_ = c;
+		else partial_ = c;
+		partial_tail_ = c;
+	}
+
+private:
+	chunk_t* chunks_ = nullptr;
+	chunk_t* chunks_tail_ = nullptr;
+	slot_t* free_ = nullptr;
+	slot_t* free_tail_ = nullptr;
+	// chunks other than the first one that still have unused slots
+	chunk_t* partial_ = nullptr;
+	chunk_t* partial_tail_ = nullptr;
+	std::size_t capacity_ = 0;
+};
+
+}
+
+/*
+ * pairing heap: a tree where every node is ordered before its children, the first child
+ * of each node linked to the next through sibling pointers. Two heaps are melded by
+ * making the root ordered last the first child of the other, so push and meld are O(1).
+ * pop removes the root and melds its children in two passes, pairs from left to right
+ * then the pairs from right to left, amortized O(log n). decrease_key cuts the subtree
+ * of the element off and melds it with the root, amortized o(log n).
+ * Nodes come from a pool owned by the heap; meld hands the pool of the other heap over
+ * with its elements, so the positions of those stay valid and now designate elements
+ * of this heap. Nodes never move, a position is valid until its element is popped or removed.
+ */
+template <typename T, typename TComparator = std::less<T>>
+class pairing_heap
+{
+	struct node_t
+	{
+		T value_;
+		node_t* child_;
+		node_t* sibling_;
+		// the parent for a first child, the previous sibling otherwise
+		node_t* prev_;
+	};
+
+public:
+	class position
+	{
+	public:
+		explicit position() = default;
+		T const& operator*() const { return node_->value_; }
+		bool operator==(position const& rhs) const { return node_ == rhs.node_; }
+		bool operator!=(position const& rhs) const { return !(*this == rhs); }
+
+		friend class pairing_heap;
+	private:
+		explicit position(node_t* node) : node_(node) {}
+
+		node_t* node_ = nullptr;
+	};
+
+	explicit pairing_heap() = default;
+	pairing_heap(pairing_heap const& rhs) = delete;
+	pairing_heap& operator=(pairing_heap const& rhs) = delete;
+
+	pairing_heap(pairing_heap&& rhs) noexcept { swap(rhs); }
+	pairing_heap& operator=(pairing_heap&& rhs) noexcept
+	{
+		swap(rhs);
+		return *this;
+	}
+
+	~pairing_heap() { destroy_all(); }
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+	// number of elements the heap can hold before allocating again
+	std::size_t capacity() const { return pool_.capacity(); }
+	const T& front() const { return root_->value_; }
+
+	position push(T const& value) { return emplace(value); }
+	position push(T&& value) { return emplace(std::move(value)); }
+
+	template <typename... Args>
+	position emplace(Args&&... args)
+	{
+		void* p = pool_.allocate();
+		node_t* x;
+		try
+		{
+			x = new (p) node_t{ T(std::forward<Args>(args)...), nullptr, nullptr, nullptr };
+		}
+		catch (...)
+		{
+			pool_.deallocate(p);
+			throw;
+		}
+		root_ = root_ ? link(root_, x) : x;
+		++size_;
+		return position(x);
+	}
+
+	void pop()
+	{
+		node_t* old = root_;
+		root_ = merge_pairs(old->child_);
+		release(old);
+	}
+
+	// moves the front element out and pops it
+	T pop_value()
+	{
+		T value = std::move(root_->value_);
+		pop();
+		return value;
+	}
+
+	void remove(position const& p)
+	{
+		node_t* x = p.node_;
+		if (x == root_) return pop();
+		cut(x);
+		node_t* children = merge_pairs(x->child_);
+		if (children) root_ = link(root_, children);
+		release(x);
+	}
+
+	// for a value that is not ordered after the current one, p keeps designating the element
+	void decrease_key(position const& p, T const& value) { update(p, T(value)); }
+	void decrease_key(position const& p, T&& value) { update(p, std::move(value)); }
+
+	// moves every element of rhs into this heap in O(1), positions into rhs now designate them here
+	void meld(pairing_heap& rhs)
+	{
+		if (&rhs == this || rhs.empty()) return;
+		pool_.splice(rhs.pool_);
+		root_ = root_ ? link(root_, rhs.root_) : rhs.root_;
+		size_ += rhs.size_;
+		rhs.root_ = nullptr;
+		rhs.size_ = 0;
+	}
+
+	void swap(pairing_heap& rhs) noexcept
+	{
+		pool_.swap(rhs.pool_);
+		std::swap(root_, rhs.root_);
+		std::swap(size_, rhs.size_);
+		std::swap(comp_, rhs.comp_);
+	}
+
+protected:
+	void update(position const& p, T&& value)
+	{
+		node_t* x = p.node_;
+		if (comp_(x->value_, value)) throw std::runtime_error("the new value is ordered after the current one");
+		x->value_ = std::move(value);
+		if (x == root_) return;
+		cut(x);
+		root_ = link(root_, x);
+	}
+
+	// a and b are roots, the one ordered last becomes the first child of the other
+	node_t* link(node_t* a, node_t* b)
+	{
+		if (comp_(b->value_, a->value_)) std::swap(a, b);
+		b->prev_ = a;
+		b->sibling_ = a->child_;
+		if (a->child_) a->child_->prev_ = b;
+		a->child_ = b;
+		a->sibling_ = nullptr;
+		a->prev_ = nullptr;
+		return a;
+	}
+
+	// detaches the subtree of x, which is not the root, from its parent and siblings
+	void cut(node_t* x)
+	{
+		if (x->prev_->child_ == x) x->prev_->child_ = x->sibling_;
+		else x->prev_->sibling_ = x->sibling_;
+		if (x->sibling_) x->sibling_->prev_ = x->prev_;
+		x->sibling_ = nullptr;
+		x->prev_ = nullptr;
+	}
+
+	// melds a list of siblings into one tree, chaining the pairs in reverse through sibling_
+	node_t* merge_pairs(node_t* first)
+	{
+		if (!first) return nullptr;
+		node_t* pairs = nullptr;
+		while (first)
+		{
+			node_t* a = first;
+			node_t* b = a->sibling_;
+			first = b ? b->sibling_ : nullptr;
+			if (b) a = link(a, b);
+			a->sibling_ = pairs;
+			pairs = a;
+		}
+		node_t* root = pairs;
+		pairs = pairs->sibling_;
+		root->sibling_ = nullptr;
+		root->prev_ = nullptr;
+		while (pairs)
+		{
+			node_t* next = pairs->sibling_;
+			root = link(root, pairs);
+			pairs = next;
+		}
+		return root;
+	}
+
+	void release(node_t* x)
+	{
+		x->~node_t();
+		pool_.deallocate(x);
+		--size_;
+	}
+
+	// the pool frees the chunks, values still need their destructor.
+	// Nodes left to destroy are chained through sibling_, so the walk never allocates
+	void destroy_all() noexcept
+	{
+		if (std::is_trivially_destructible<T>::value) return;
+		node_t* pending = root_;
+		while (pending)
+		{
+			node_t* x = pending;
+			pending = x->sibling_;
+			if (node_t* first = x->child_)
+			{
+				node_t* last = first;
+				while (last->sibling_) last = last->sibling_;
+				last->sibling_ = pending;
+				pending = first;
+			}
+			x->~node_t();
+		}
+	}
+
+private:
+	detail::node_pool<node_t> pool_{};
+	node_t* root_ = nullptr;
+	std::size_t size_ = 0;
+	TComparator comp_;
+};
+
+}
\ No newline at end of file
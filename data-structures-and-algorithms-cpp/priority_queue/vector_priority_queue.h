@@ -1,62 +1,187 @@
 #pragma once
 
+#include <new>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
 #include <cstddef>
-
-#include "tree/vector_complete_binary_tree.h"
+#include <functional>
 
 namespace data_structures_cpp {
 
-template <typename T, typename TComparator = std::less<T>>
+namespace detail {
+
+// allocates on cache line boundaries, so that groups of siblings can be made to fill whole lines
+template <typename T>
+struct cache_aligned_allocator
+{
+	using value_type = T;
+	static constexpr std::size_t alignment = alignof(T) > 64 ? alignof(T) : 64;
+
+	cache_aligned_allocator() = default;
+	template <typename U>
+	cache_aligned_allocator(cache_aligned_allocator<U> const&) {}
+
+	T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignment))); }
+	void deallocate(T* p, std::size_t) { ::operator delete(p, std::align_val_t(alignment)); }
+
+	template <typename U>
+	bool operator==(cache_aligned_allocator<U> const&) const { return true; }
+	template <typename U>
+	bool operator!=(cache_aligned_allocator<U> const&) const { return false; }
+};
+
+}
+
+/*
+ * d-ary heap of Arity children per node, stored in a contiguous array.
+ * Children of the node at index i are at Arity * i + 1 to Arity * i + Arity; the array
+ * starts with Arity - 1 unused slots so that every group of siblings begins at a multiple
+ * of Arity, which is a cache line boundary when Arity * sizeof(T) is 64 bytes.
+ * Wider heaps are shallower: pop compares more children per level but visits fewer levels
+ * and cache lines, push only compares with ancestors and gets strictly cheaper.
+ * Elements are moved into a hole rather than swapped while sifting.
+ * Building from a range, or appending a range at least half as long as the queue, heapifies
+ * bottom-up in O(n) instead of sifting every element up.
+ */
+template <typename T, typename TComparator = std::less<T>, std::size_t Arity = 2>
 class vector_priority_queue
 {
+	static_assert(Arity >= 2, "a heap needs at least two children per node");
+
 public:
-	using tree_t = vector_complete_binary_tree<T>;
-	using position_t = typename tree_t::position_t;
+	explicit vector_priority_queue() = default;
 
-	std::size_t size() const { return tree_.size(); }
-	bool empty() const { return tree_.size() == 0; }
+	template <typename InputIt>
+	vector_priority_queue(InputIt first, InputIt last)
+	{
+		heap_.insert(heap_.end(), first, last);
+		heapify();
+	}
+
+	std::size_t size() const { return heap_.size() - offset; }
+	bool empty() const { return size() == 0; }
 
 	void push(const T& value)
 	{
-		tree_.add(value);
-		position_t p = tree_.last();
-		while (!tree_.is_root(p))
+		heap_.push_back(value);
+		sift_up(size() - 1);
+	}
+
+	void push(T&& value)
+	{
+		heap_.push_back(std::move(value));
+		sift_up(size() - 1);
+	}
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		heap_.emplace_back(std::forward<Args>(args)...);
+		sift_up(size() - 1);
+	}
+
+	template <typename InputIt>
+	void push_range(InputIt first, InputIt last)
+	{
+		std::size_t old_size = size();
+		heap_.insert(heap_.end(), first, last);
+		if (size() - old_size >= old_size / 2) heapify();
+		else for (std::size_t i = old_size; i < size(); ++i) sift_up(i);
+	}
+
+	const T& front() const { return at(0); }
+
+	void pop()
+	{
+		if (size() > 1) at(0) = std::move(heap_.back());
+		heap_.pop_back();
+		if (size() > 1) sift_down(0);
+	}
+
+	// moves the front element out and pops it
+	T pop_value()
+	{
+		T value = std::move(at(0));
+		pop();
+		return value;
+	}
+
+	/*
+	 * moves the min(k, size()) front elements to out in order and pops them.
+	 * Small k pops one at a time, O(k log n). From k = size() / 4 on, the k front elements
+	 * are selected and sorted and the rest is heapified again, O(n + k log k).
+	 */
+	template <typename OutputIt>
+	OutputIt pop_n(std::size_t k, OutputIt out)
+	{
+		if (k > size()) k = size();
+		if (k < size() / 4)
 		{
-			position_t q = tree_.parent(p);
-			if (!comp_(*p, *q)) break;
-			tree_.swap(p, q);
-			p = q;
+			for (; k > 0; --k)
+			{
+				*out++ = std::move(at(0));
+				pop();
+			}
+			return out;
 		}
+		auto first = heap_.begin() + offset;
+		std::nth_element(first, first + k, heap_.end(), comp_);
+		std::sort(first, first + k, comp_);
+		out = std::move(first, first + k, out);
+		heap_.erase(first, first + k);
+		heapify();
+		return out;
 	}
 
-	const T& front() { return *tree_.root(); }
-	
-	void pop() 
-	{ 
-		if (size() == 1)
+protected:
+	static constexpr std::size_t offset = Arity - 1;
+
+	T& at(std::size_t i) { return heap_[i + offset]; }
+	T const& at(std::size_t i) const { return heap_[i + offset]; }
+
+	// Floyd's construction: sifting down every parent from the last one is O(n) overall
+	void heapify()
+	{
+		if (size() < 2) return;
+		for (std::size_t i = (size() - 2) / Arity + 1; i-- > 0;) sift_down(i);
+	}
+
+	void sift_up(std::size_t i)
+	{
+		T value = std::move(at(i));
+		while (i > 0)
 		{
-			tree_.remove();
+			std::size_t parent = (i - 1) / Arity;
+			if (!comp_(value, at(parent))) break;
+			at(i) = std::move(at(parent));
+			i = parent;
 		}
-		else
+		at(i) = std::move(value);
+	}
+
+	void sift_down(std::size_t i)
+	{
+		T value = std::move(at(i));
+		std::size_t n = size();
+		for (;;)
 		{
-			position_t q = tree_.root();
-			tree_.swap(q, tree_.last());
-			tree_.remove();
-			while (tree_.has_left(q))
-			{
-				position_t p = tree_.left(q);
-				if (tree_.has_right(q) && comp_(*tree_.right(q), *p)) p = tree_.right(q);
-				if (comp_(*p, *q))
-				{
-					tree_.swap(p, q);
-					q = p;
-				}
-				else break;
-			}
+			std::size_t first = Arity * i + 1;
+			if (first >= n) break;
+			// all the siblings lie in the same cache line, the best of them is found in one pass
+			std::size_t last = first + Arity < n ? first + Arity : n;
+			std::size_t best = first;
+			for (std::size_t c = first + 1; c < last; ++c) best = comp_(at(c), at(best)) ? c : best;
+			if (!comp_(at(best), value)) break;
+			at(i) = std::move(at(best));
+			i = best;
 		}
+		at(i) = std::move(value);
 	}
+
 private:
-	vector_complete_binary_tree<T> tree_;
+	std::vector<T, detail::cache_aligned_allocator<T>> heap_ = std::vector<T, detail::cache_aligned_allocator<T>>(offset);
 	TComparator comp_;
 };
 
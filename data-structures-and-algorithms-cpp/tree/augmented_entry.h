@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <algorithm>
+
+namespace data_structures_cpp {
+
+template <class K, class V, class Entry> class binary_search_tree;
+
+/*
+ * search tree entry carrying an aggregate of its whole subtree.
+ * Augmentation is a policy describing a monoid over entries:
+ *   using aggregate_type = ...;
+ *   static aggregate_type identity();                        // aggregate of an external node
+ *   static aggregate_type make(Entry const& e);               // contribution of a single entry
+ *   static aggregate_type combine(aggregate_type const& lhs, aggregate_type const& rhs);
+ * combine must be associative, entries are combined in inorder.
+ * The search tree recomputes aggregates bottom-up whenever it expands an external node,
+ * removes above an external node or restructures a trinode.
+ */
+template <class Entry, class Augmentation>
+class augmented_entry : public Entry
+{
+public:
+	template <class T, class U, class E> friend class binary_search_tree;
+	using key_type = typename Entry::key_type;
+	using value_type = typename Entry::value_type;
+	using augmentation_t = Augmentation;
+	using aggregate_type = typename Augmentation::aggregate_type;
+
+	augmented_entry(key_type const& key = key_type(), value_type const& value = value_type())
+		: Entry(key, value), aggregate_(Augmentation::identity())
+	{}
+
+	aggregate_type const& aggregate() const { return aggregate_; }
+private:
+	aggregate_type aggregate_;
+};
+
+template <class Entry>
+struct augmentation_traits
+{
+	static constexpr bool enabled = false;
+	using augmentation_t = void;
+};
+
+template <class Entry, class Augmentation>
+struct augmentation_traits<augmented_entry<Entry, Augmentation>>
+{
+	static constexpr bool enabled = true;
+	using augmentation_t = Augmentation;
+};
+
+struct subtree_size
+{
+	using aggregate_type = std::size_t;
+	static aggregate_type identity() { return 0; }
+	template <class Entry>
+	static aggregate_type make(Entry const&) { return 1; }
+	static aggregate_type combine(aggregate_type lhs, aggregate_type rhs) { return lhs + rhs; }
+};
+
+template <class V>
+struct value_sum
+{
+	using aggregate_type = V;
+	static aggregate_type identity() { return V(); }
+	template <class Entry>
+	static aggregate_type make(Entry const& e) { return e.value(); }
+	static aggregate_type combine(aggregate_type const& lhs, aggregate_type const& rhs) { return lhs + rhs; }
+};
+
+template <class V>
+struct value_min
+{
+	using aggregate_type = V;
+	static aggregate_type identity() { return std::numeric_limits<V>::max(); }
+	template <class Entry>
+	static aggregate_type make(Entry const& e) { return e.value(); }
+	static aggregate_type combine(aggregate_type const& lhs, aggregate_type const& rhs) { return std::min(lhs, rhs); }
+};
+
+template <class V>
+struct value_max
+{
+	using aggregate_type = V;
+	static aggregate_type identity() { return std::numeric_limits<V>::lowest(); }
+	template <class Entry>
+	static aggregate_type make(Entry const& e) { return e.value(); }
+	static aggregate_type combine(aggregate_type const& lhs, aggregate_type const& rhs) { return std::max(lhs, rhs); }
+};
+
+/*
+ * augmentation with subtree sizes, enabling select(i) and rank(k) in O(height)
+ */
+template <class Entry>
+using order_statistic_entry = augmented_entry<Entry, subtree_size>;
+
+}
\ No newline at end of file
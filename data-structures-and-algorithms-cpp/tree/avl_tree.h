@@ -9,13 +9,13 @@
 
 namespace data_structures_cpp {
 
-template <class K, class V> class avl_tree;
+template <class K, class V, class Entry> class avl_tree;
 
 template <class K, class V>
 class avl_entry : public key_value_pair<K,V>
 {
 public:
-	friend class avl_tree<K,V>;
+	template <class T, class U, class E> friend class avl_tree;
 	using key_type = typename key_value_pair<K,V>::key_type;
 	using value_type = typename key_value_pair<K,V>::value_type;
 	
@@ -30,23 +30,27 @@ protected:
 	void set_height(std::size_t height) { height_ = height; }
 };
 
-template <class K, class V>
-class avl_tree : public binary_search_tree<K, V, avl_entry<K, V>>
+/*
+ * Entry must be avl_entry<K, V> or an augmentation of it,
+ * such as order_statistic_entry<avl_entry<K, V>>
+ */
+template <class K, class V, class Entry = avl_entry<K, V>>
+class avl_tree : public binary_search_tree<K, V, Entry>
 {
 public:
-	using entry_t = avl_entry<K, V>;
-	using iterator_t = typename binary_search_tree<K, V, avl_entry<K, V>>::iterator;
+	using entry_t = Entry;
+	using iterator_t = typename binary_search_tree<K, V, Entry>::iterator;
 protected:
 	using key_type = typename entry_t::key_type;
 	using value_type = typename entry_t::value_type;
-	using tree_t = binary_search_tree<K, V, avl_entry<K, V>>;
+	using tree_t = binary_search_tree<K, V, Entry>;
 	using position_t = typename tree_t::position_t;
 public:
 	explicit avl_tree() : tree_t() {}
 
 	iterator_t insert(key_type const& k, value_type const& v)
 	{
-		position_t inserted = inserter(k, v);
+		position_t inserted = tree_t::inserter(k, v);
 		set_height(inserted);
 		rebalance(inserted);
 		return iterator_t(inserted);
@@ -54,15 +58,15 @@ public:
 
 	void erase(key_type const& k)
 	{
-		position_t erased = finder(k, tree_t::root());
-		if (iterator(erased) == tree_t::end()) throw std::runtime_error("no such entry with specified key");
-		position_t replaced = eraser(pos);
+		position_t erased = tree_t::finder(k, tree_t::root());
+		if (erased.external()) throw std::runtime_error("no such entry with specified key");
+		position_t replaced = tree_t::eraser(erased);
 		rebalance(replaced);
 	}
 
 	void erase(iterator_t& it)
 	{
-		position_t replaced = eraser(it.position());
+		position_t replaced = tree_t::eraser(it.position());
 		rebalance(replaced);
 	}
 protected:
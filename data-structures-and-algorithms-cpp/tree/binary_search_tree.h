@@ -1,9 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <type_traits>
 
 #include "utils/utils.h"
 #include "linked_binary_tree.h"
+#include "augmented_entry.h"
 
 namespace data_structures_cpp {
 
@@ -17,7 +19,10 @@ public:
 	using key_type = typename Entry::key_type;
 	using value_type = typename Entry::value_type;
 	class iterator;
-
+protected:
+	using augmentation_t = typename augmentation_traits<entry_t>::augmentation_t;
+	static constexpr bool order_statistic_v = std::is_same<augmentation_t, subtree_size>::value;
+public:
 	explicit binary_search_tree() : tree_(), size_(0) 
 	{
 		tree_.add_root();
@@ -63,6 +68,60 @@ public:
 		return iterator(tree_.root());
 	}
 
+	// i-th smallest entry, counting from 0, or end() if i >= size()
+	iterator select(std::size_t i)
+	{
+		static_assert(order_statistic_v, "select requires an order_statistic_entry");
+		if (i >= size_) return end();
+		position_t pos = root();
+		while (true)
+		{
+			std::size_t left_size = aggregate_of(pos.left());
+			if (i < left_size) pos = pos.left();
+			else if (i == left_size) return iterator(pos);
+			else
+			{
+				i -= left_size + 1;
+				pos = pos.right();
+			}
+		}
+	}
+
+	// number of entries with key strictly less than k
+	std::size_t rank(key_type const& k) const
+	{
+		static_assert(order_statistic_v, "rank requires an order_statistic_entry");
+		std::size_t r = 0;
+		position_t pos = root();
+		while (!pos.external())
+		{
+			if ((*pos).key_ < k)
+			{
+				r += aggregate_of(pos.left()) + 1;
+				pos = pos.right();
+			}
+			else pos = pos.left();
+		}
+		return r;
+	}
+
+	// aggregate of all entries with lo <= key < hi, combined in inorder
+	auto aggregate(key_type const& lo, key_type const& hi) const
+	{
+		static_assert(augmentation_traits<entry_t>::enabled, "aggregate requires an augmented_entry");
+		position_t pos = root();
+		while (!pos.external())
+		{
+			if ((*pos).key_ < lo) pos = pos.right();
+			else if (!((*pos).key_ < hi)) pos = pos.left();
+			else break; // subtrees of pos hold both range ends
+		}
+		if (pos.external()) return augmentation_t::identity();
+		return augmentation_t::combine(
+			augmentation_t::combine(aggregate_from(pos.left(), lo), augmentation_t::make(*pos)),
+			aggregate_below(pos.right(), hi));
+	}
+
 protected:
 	position_t root() const { return tree_.root().left(); }
 
@@ -82,6 +141,7 @@ protected:
 		(*pos).key_ = k;
 		(*pos).value_ = v;
 		++size_;
+		update_aggregates(pos);
 		return pos;
 	}
 
@@ -98,12 +158,85 @@ protected:
 			remove_pos = it.pos_.left(); // get his left external child
 		}
 		--size_;
-		return tree_.remove_above_external(remove_pos);
+		position_t replaced = tree_.remove_above_external(remove_pos);
+		update_aggregates(replaced.parent());
+		return replaced;
 	}
 
 	position_t trinode_restructure(position_t const& x)
 	{
-		return tree_.trinode_restructure(x);
+		position_t b = tree_.trinode_restructure(x);
+		// only a, b and c change subtrees, b's ancestors keep their aggregates
+		update_aggregate(b.left());
+		update_aggregate(b.right());
+		update_aggregate(b);
+		return b;
+	}
+
+	static auto aggregate_of(position_t const& pos)
+	{
+		if constexpr (augmentation_traits<entry_t>::enabled)
+			return pos.external() ? augmentation_t::identity() : pos->aggregate_;
+		else
+			return 0;
+	}
+
+	static void update_aggregate(position_t pos)
+	{
+		if constexpr (augmentation_traits<entry_t>::enabled)
+		{
+			pos->aggregate_ = augmentation_t::combine(
+				augmentation_t::combine(aggregate_of(pos.left()), augmentation_t::make(*pos)),
+				aggregate_of(pos.right()));
+		}
+	}
+
+	// recompute aggregates on the path from pos up to the root
+	void update_aggregates(position_t pos)
+	{
+		if constexpr (augmentation_traits<entry_t>::enabled)
+		{
+			position_t sentinel = tree_.root();
+			while (!(pos == sentinel))
+			{
+				update_aggregate(pos);
+				pos = pos.parent();
+			}
+		}
+	}
+
+	// aggregate of entries with key >= lo in the subtree of pos
+	static auto aggregate_from(position_t pos, key_type const& lo)
+	{
+		auto result = augmentation_t::identity();
+		while (!pos.external())
+		{
+			if ((*pos).key_ < lo) pos = pos.right();
+			else
+			{
+				result = augmentation_t::combine(
+					augmentation_t::combine(augmentation_t::make(*pos), aggregate_of(pos.right())), result);
+				pos = pos.left();
+			}
+		}
+		return result;
+	}
+
+	// aggregate of entries with key < hi in the subtree of pos
+	static auto aggregate_below(position_t pos, key_type const& hi)
+	{
+		auto result = augmentation_t::identity();
+		while (!pos.external())
+		{
+			if (!((*pos).key_ < hi)) pos = pos.left();
+			else
+			{
+				result = augmentation_t::combine(
+					result, augmentation_t::combine(aggregate_of(pos.left()), augmentation_t::make(*pos)));
+				pos = pos.right();
+			}
+		}
+		return result;
 	}
 private:
 	binary_tree_t tree_;
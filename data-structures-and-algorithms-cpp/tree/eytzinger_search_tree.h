@@ -0,0 +1,93 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <cstddef>
+
+#include "utils/utils.h"
+#include "utils/prefetch.h"
+
+namespace data_structures_cpp {
+
+/*
+ * static search tree over sorted keys laid out in Eytzinger (bfs) order,
+ * using the same 1-based numbering as vector_binary_tree: children of v are 2v and 2v+1.
+ * The tree is complete, so no slot is wasted, and the top levels that every search
+ * goes through share a few cache lines. Searches are branchless and prefetch the
+ * cache line holding the descendants a few levels down.
+ */
+template <class K, class V>
+class eytzinger_search_tree
+{
+public:
+	using entry_t = key_value_pair<K, V>;
+	using key_type = typename entry_t::key_type;
+	using value_type = typename entry_t::value_type;
+
+	explicit eytzinger_search_tree() : keys_(1), values_(1) {}
+
+	explicit eytzinger_search_tree(std::vector<entry_t> entries)
+		: keys_(entries.size() + 1), values_(entries.size() + 1)
+	{
+		std::stable_sort(entries.begin(), entries.end(),
+			[](entry_t const& lhs, entry_t const& rhs) { return lhs.key_ < rhs.key_; });
+		std::size_t next = 0;
+		build(1, entries, next);
+	}
+
+	std::size_t size() const { return keys_.size() - 1; }
+	bool empty() const { return size() == 0; }
+
+	value_type const* find(key_type const& k) const
+	{
+		std::size_t v = lower_bound_index(k);
+		if (v == 0 || k < keys_[v]) return nullptr;
+		return &values_[v];
+	}
+
+	// first entry whose key is not less than k
+	std::optional<entry_t> lower_bound(key_type const& k) const
+	{
+		std::size_t v = lower_bound_index(k);
+		if (v == 0) return std::nullopt;
+		return entry_t(keys_[v], values_[v]);
+	}
+
+protected:
+	// fill slots of the subtree of v in inorder with the next sorted entries
+	void build(std::size_t v, std::vector<entry_t> const& entries, std::size_t& next)
+	{
+		if (v > size()) return;
+		build(2 * v, entries, next);
+		keys_[v] = entries[next].key_;
+		values_[v] = entries[next].value_;
+		++next;
+		build(2 * v + 1, entries, next);
+	}
+
+	// slot of the first key not less than k, or 0 if there is none
+	std::size_t lower_bound_index(key_type const& k) const
+	{
+		std::size_t const n = size();
+		std::size_t v = 1;
+		while (v <= n)
+		{
+			prefetch(&keys_[std::min(v * prefetch_stride, n)]);
+			v = 2 * v + (keys_[v] < k);
+		}
+		// v encodes the path taken, the answer is where we last went left:
+		// strip the trailing right turns, then the final left turn
+		while (v & 1) v >>= 1;
+		return v >> 1;
+	}
+
+private:
+	// descendants of v that are log2(prefetch_stride) levels down are contiguous from v * prefetch_stride
+	static constexpr std::size_t prefetch_stride = sizeof(key_type) >= 64 ? 1 : 64 / sizeof(key_type);
+
+	std::vector<key_type> keys_;
+	std::vector<value_type> values_;
+};
+
+}
\ No newline at end of file
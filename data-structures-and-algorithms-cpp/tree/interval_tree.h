@@ -0,0 +1,77 @@
+#pragma once
+
+#include <list>
+#include <limits>
+#include <algorithm>
+
+#include "avl_tree.h"
+#include "augmented_entry.h"
+
+namespace data_structures_cpp {
+
+/*
+ * closed interval [low, high], ordered by low endpoint then high endpoint
+ */
+template <class T>
+struct interval
+{
+	T low{};
+	T high{};
+
+	bool overlaps(T const& lo, T const& hi) const { return !(hi < low) && !(high < lo); }
+	bool operator<(interval const& rhs) const { return low < rhs.low || (!(rhs.low < low) && high < rhs.high); }
+	bool operator==(interval const& rhs) const { return low == rhs.low && high == rhs.high; }
+};
+
+template <class T>
+struct interval_max_high
+{
+	using aggregate_type = T;
+	static aggregate_type identity() { return std::numeric_limits<T>::lowest(); }
+	template <class Entry>
+	static aggregate_type make(Entry const& e) { return e.key().high; }
+	static aggregate_type combine(aggregate_type const& lhs, aggregate_type const& rhs) { return std::max(lhs, rhs); }
+};
+
+/*
+ * avl tree keyed by intervals, each node keeps the maximum high endpoint of its subtree
+ * so that subtrees which cannot overlap a query are pruned
+ */
+template <class T, class V>
+class interval_tree : public avl_tree<interval<T>, V, augmented_entry<avl_entry<interval<T>, V>, interval_max_high<T>>>
+{
+public:
+	using interval_t = interval<T>;
+	using entry_t = augmented_entry<avl_entry<interval_t, V>, interval_max_high<T>>;
+	using tree_t = avl_tree<interval_t, V, entry_t>;
+	using iterator_t = typename tree_t::iterator_t;
+protected:
+	using position_t = typename tree_t::position_t;
+public:
+	explicit interval_tree() : tree_t() {}
+
+	iterator_t insert(T const& low, T const& high, V const& v)
+	{
+		return tree_t::insert(interval_t{ low, high }, v);
+	}
+
+	// all entries whose interval overlaps [low, high], in increasing order of interval
+	std::list<iterator_t> overlapping(T const& low, T const& high)
+	{
+		std::list<iterator_t> result{};
+		overlapping(tree_t::root(), low, high, result);
+		return result;
+	}
+protected:
+	void overlapping(position_t const& pos, T const& low, T const& high, std::list<iterator_t>& result)
+	{
+		if (pos.external() || pos->aggregate() < low) return;
+		overlapping(pos.left(), low, high, result);
+		// every interval to the right starts at or after this one
+		if (high < pos->key().low) return;
+		if (pos->key().overlaps(low, high)) result.push_back(iterator_t(pos));
+		overlapping(pos.right(), low, high, result);
+	}
+};
+
+}
\ No newline at end of file
@@ -7,6 +7,7 @@
 
 #include "linked_binary_tree_node.h"
 #include "linked_binary_tree_position.h"
+#include "linked_binary_tree_traversal.h"
 
 namespace data_structures_cpp {
 
@@ -23,12 +24,22 @@ public:
 	linked_binary_tree(linked_binary_tree const& rhs) = delete;
 	linked_binary_tree& operator=(linked_binary_tree const& rhs) = delete;
 
+	// frees nodes in postorder, detaching each leaf from its parent, without allocating
 	~linked_binary_tree()
 	{
-		if (root_ == nullptr) return;
-		for (auto pos : positions())
+		node_t* v = root_;
+		while (v)
 		{
-			delete pos.v_;
+			if (v->left_) v = v->left_;
+			else if (v->right_) v = v->right_;
+			else
+			{
+				node_t* parent = v->parent_;
+				if (parent && parent->left_ == v) parent->left_ = nullptr;
+				else if (parent) parent->right_ = nullptr;
+				delete v;
+				v = parent;
+			}
 		}
 	}
 
@@ -78,14 +89,34 @@ public:
 		return position_t(sibling);
 	}
 
+	// materializes all positions in preorder, prefer the allocation free traversals below
 	children_t positions() const
 	{
 		children_t list{};
-		if (empty()) return list;
-		preorder(root_, list);
+		for (auto pos : preorder()) list.push_back(pos);
 		return list;
 	}
 
+	linked_binary_tree_traversal<T, traversal_tags::preorder> preorder() const
+	{
+		return linked_binary_tree_traversal<T, traversal_tags::preorder>(root_);
+	}
+
+	linked_binary_tree_traversal<T, traversal_tags::inorder> inorder() const
+	{
+		return linked_binary_tree_traversal<T, traversal_tags::inorder>(root_);
+	}
+
+	linked_binary_tree_traversal<T, traversal_tags::postorder> postorder() const
+	{
+		return linked_binary_tree_traversal<T, traversal_tags::postorder>(root_);
+	}
+
+	linked_binary_tree_traversal<T, traversal_tags::level_order> level_order() const
+	{
+		return linked_binary_tree_traversal<T, traversal_tags::level_order>(root_);
+	}
+
 	position_t trinode_restructure(position_t const& x)
 	{
 		position_t y = x.parent();
@@ -119,7 +150,7 @@ public:
 			// x is y's right and y is z's right
 			else
 			{
-				a = z; b = y; c = z;
+				a = z; b = y; c = x;
 				t0 = z.left(); t1 = y.left(); t2 = x.left(); t3 = x.right();
 			}
 		}
@@ -139,14 +170,6 @@ public:
 		return b;
 	}
 
-protected:
-	void preorder(node_t* v, children_t& positions) const
-	{
-		positions.push_back(position_t(v));
-		if (v->left_) preorder(v->left_, positions);
-		if (v->right_) preorder(v->right_, positions);
-	}
-
 private:
 	node_t* root_{ nullptr };
 	std::size_t size_{ 0 };
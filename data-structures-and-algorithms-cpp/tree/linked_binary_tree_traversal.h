@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+
+#include "linked_binary_tree_node.h"
+#include "linked_binary_tree_position.h"
+
+namespace data_structures_cpp {
+
+struct traversal_tags
+{
+	struct preorder {};
+	struct inorder {};
+	struct postorder {};
+	struct level_order {};
+};
+
+/*
+ * forward iterator over the positions of a linked_binary_tree in the given Order.
+ * It walks the parent pointers and keeps O(1) state, so traversals never allocate.
+ * Preorder, inorder and postorder visit every edge at most twice, O(n) overall.
+ * Level order rescans the levels above the current one to find the next node of a level,
+ * O(n * height) overall.
+ */
+template <typename T, typename Order>
+class linked_binary_tree_iterator
+{
+public:
+	using node_t = linked_binary_tree_node<T>;
+	using position_t = linked_binary_tree_position<T>;
+
+	explicit linked_binary_tree_iterator(node_t* root = nullptr) : root_(root), v_(first(root, Order{})) {}
+
+	position_t operator*() const { return position_t(v_); }
+	bool operator==(linked_binary_tree_iterator const& rhs) const { return v_ == rhs.v_; }
+	bool operator!=(linked_binary_tree_iterator const& rhs) const { return !(*this == rhs); }
+
+	linked_binary_tree_iterator& operator++()
+	{
+		advance(Order{});
+		return *this;
+	}
+
+private:
+	static node_t* leftmost(node_t* v)
+	{
+		while (v->left_) v = v->left_;
+		return v;
+	}
+
+	// first leaf found going left whenever possible
+	static node_t* first_leaf(node_t* v)
+	{
+		while (v->left_ || v->right_) v = v->left_ ? v->left_ : v->right_;
+		return v;
+	}
+
+	static node_t* first(node_t* root, traversal_tags::preorder) { return root; }
+	static node_t* first(node_t* root, traversal_tags::inorder) { return root ? leftmost(root) : nullptr; }
+	static node_t* first(node_t* root, traversal_tags::postorder) { return root ? first_leaf(root) : nullptr; }
+	static node_t* first(node_t* root, traversal_tags::level_order) { return root; }
+
+	void advance(traversal_tags::preorder)
+	{
+		if (v_->left_) { v_ = v_->left_; return; }
+		if (v_->right_) { v_ = v_->right_; return; }
+		node_t* parent = v_->parent_;
+		while (parent && (v_ == parent->right_ || !parent->right_))
+		{
+			v_ = parent;
+			parent = parent->parent_;
+		}
+		v_ = parent ? parent->right_ : nullptr;
+	}
+
+	void advance(traversal_tags::inorder)
+	{
+		if (v_->right_) { v_ = leftmost(v_->right_); return; }
+		node_t* parent = v_->parent_;
+		while (parent && v_ == parent->right_)
+		{
+			v_ = parent;
+			parent = parent->parent_;
+		}
+		v_ = parent;
+	}
+
+	void advance(traversal_tags::postorder)
+	{
+		node_t* parent = v_->parent_;
+		if (parent && v_ == parent->left_ && parent->right_) v_ = first_leaf(parent->right_);
+		else v_ = parent;
+	}
+
+	void advance(traversal_tags::level_order)
+	{
+		// next node at the same depth, otherwise the first node one level deeper
+		node_t* next = next_at_depth(v_, depth_, depth_);
+		if (!next)
+		{
+			++depth_;
+			next = next_at_depth(root_, 0, depth_);
+		}
+		v_ = next;
+	}
+
+	// next node at depth target after v in preorder, never descending below target
+	static node_t* next_at_depth(node_t* v, std::size_t depth, std::size_t target)
+	{
+		while (v)
+		{
+			if (depth < target && (v->left_ || v->right_))
+			{
+				v = v->left_ ? v->left_ : v->right_;
+				++depth;
+			}
+			else
+			{
+				node_t* parent = v->parent_;
+				while (parent && (v == parent->right_ || !parent->right_))
+				{
+					v = parent;
+					parent = parent->parent_;
+					--depth;
+				}
+				v = parent ? parent->right_ : nullptr;
+			}
+			if (v && depth == target) return v;
+		}
+		return nullptr;
+	}
+
+	node_t* root_;
+	node_t* v_;
+	std::size_t depth_{ 0 };
+};
+
+/*
+ * iterable view of a linked_binary_tree in the given Order
+ */
+template <typename T, typename Order>
+class linked_binary_tree_traversal
+{
+public:
+	using iterator = linked_binary_tree_iterator<T, Order>;
+
+	explicit linked_binary_tree_traversal(linked_binary_tree_node<T>* root) : root_(root) {}
+
+	iterator begin() const { return iterator(root_); }
+	iterator end() const { return iterator(); }
+private:
+	linked_binary_tree_node<T>* root_;
+};
+
+}
\ No newline at end of file
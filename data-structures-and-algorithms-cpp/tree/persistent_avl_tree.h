@@ -0,0 +1,206 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
+
+#include "utils/utils.h"
+
+namespace data_structures_cpp {
+
+/*
+ * avl tree with path copying: every update rebuilds only the nodes on the path from the
+ * root to the modified position and shares all other subtrees with previous versions.
+ * Nodes are immutable and reference counted, so a version lives for as long as some view
+ * of it does. Nodes have no parent pointer, since a shared subtree has many parents.
+ *
+ * snapshot() is O(1) and may be called concurrently with insert/erase from any thread,
+ * writers themselves must be serialized by the caller.
+ */
+template <class K, class V>
+class persistent_avl_tree
+{
+public:
+	using entry_t = key_value_pair<K, V>;
+	using key_type = typename entry_t::key_type;
+	using value_type = typename entry_t::value_type;
+	class view;
+	class iterator;
+private:
+	struct node;
+	using node_ptr = std::shared_ptr<node const>;
+	struct node
+	{
+		// entries are shared too, so path copies never copy keys or values
+		std::shared_ptr<entry_t const> value_;
+		node_ptr left_;
+		node_ptr right_;
+		std::size_t height_;
+		std::size_t size_;
+	};
+public:
+	explicit persistent_avl_tree() = default;
+
+	std::size_t size() const { return size(root_); }
+	bool empty() const { return root_ == nullptr; }
+
+	view snapshot() const { return view(std::atomic_load(&root_)); }
+
+	void insert(key_type const& k, value_type const& v)
+	{
+		std::atomic_store(&root_, inserter(root_, k, std::make_shared<entry_t>(k, v)));
+	}
+
+	void erase(key_type const& k)
+	{
+		std::atomic_store(&root_, eraser(root_, k));
+	}
+
+protected:
+	static std::size_t height(node_ptr const& v) { return v ? v->height_ : 0; }
+	static std::size_t size(node_ptr const& v) { return v ? v->size_ : 0; }
+
+	static node_ptr make_node(std::shared_ptr<entry_t const> const& value, node_ptr const& left, node_ptr const& right)
+	{
+		return std::make_shared<node>(node{
+			value, left, right,
+			1 + std::max(height(left), height(right)),
+			1 + size(left) + size(right) });
+	}
+
+	// builds a node over left and right, rotating once or twice if they differ in height by 2
+	static node_ptr balance(std::shared_ptr<entry_t const> const& value, node_ptr const& left, node_ptr const& right)
+	{
+		if (height(left) > height(right) + 1)
+		{
+			if (height(left->left_) >= height(left->right_))
+				return make_node(left->value_, left->left_, make_node(value, left->right_, right));
+			node_ptr const& x = left->right_;
+			return make_node(x->value_, make_node(left->value_, left->left_, x->left_), make_node(value, x->right_, right));
+		}
+		if (height(right) > height(left) + 1)
+		{
+			if (height(right->right_) >= height(right->left_))
+				return make_node(right->value_, make_node(value, left, right->left_), right->right_);
+			node_ptr const& x = right->left_;
+			return make_node(x->value_, make_node(value, left, x->left_), make_node(right->value_, x->right_, right->right_));
+		}
+		return make_node(value, left, right);
+	}
+
+	static node_ptr inserter(node_ptr const& v, key_type const& k, std::shared_ptr<entry_t const> const& value)
+	{
+		if (!v) return make_node(value, nullptr, nullptr);
+		if (k < v->value_->key_) return balance(v->value_, inserter(v->left_, k, value), v->right_);
+		else return balance(v->value_, v->left_, inserter(v->right_, k, value));
+	}
+
+	static node_ptr eraser(node_ptr const& v, key_type const& k)
+	{
+		if (!v) throw std::runtime_error("no such entry with specified key");
+		if (k < v->value_->key_) return balance(v->value_, eraser(v->left_, k), v->right_);
+		if (v->value_->key_ < k) return balance(v->value_, v->left_, eraser(v->right_, k));
+		if (!v->left_) return v->right_;
+		if (!v->right_) return v->left_;
+		node const* successor = v->right_.get();
+		while (successor->left_) successor = successor->left_.get();
+		return balance(successor->value_, v->left_, remove_leftmost(v->right_));
+	}
+
+	static node_ptr remove_leftmost(node_ptr const& v)
+	{
+		if (!v->left_) return v->right_;
+		return balance(v->value_, remove_leftmost(v->left_), v->right_);
+	}
+
+private:
+	node_ptr root_{};
+
+public:
+	/*
+	 * read-only handle on one version of the tree, keeps that version alive
+	 */
+	class view
+	{
+	public:
+		friend class persistent_avl_tree<K, V>;
+
+		std::size_t size() const { return persistent_avl_tree::size(root_); }
+		bool empty() const { return root_ == nullptr; }
+		std::size_t height() const { return persistent_avl_tree::height(root_); }
+
+		iterator find(key_type const& k) const
+		{
+			iterator it{};
+			node const* v = root_.get();
+			while (v)
+			{
+				it.path_.push_back(v);
+				if (k < v->value_->key_) v = v->left_.get();
+				else if (v->value_->key_ < k) v = v->right_.get();
+				else
+				{
+					// drop ancestors we went right from, they precede v in inorder
+					std::vector<node const*> path{};
+					for (std::size_t i = 0; i + 1 < it.path_.size(); ++i)
+						if (it.path_[i]->left_.get() == it.path_[i + 1]) path.push_back(it.path_[i]);
+					path.push_back(v);
+					it.path_ = std::move(path);
+					return it;
+				}
+			}
+			return end();
+		}
+
+		iterator begin() const
+		{
+			iterator it{};
+			it.push_leftmost(root_.get());
+			return it;
+		}
+
+		iterator end() const { return iterator(); }
+	private:
+		explicit view(node_ptr root) : root_(std::move(root)) {}
+		node_ptr root_;
+	};
+
+	/*
+	 * inorder iterator, valid for as long as the view it came from
+	 */
+	class iterator
+	{
+	public:
+		friend class persistent_avl_tree<K, V>;
+		friend class view;
+
+		entry_t const& operator*() const { return *path_.back()->value_; }
+		entry_t const* operator->() const { return path_.back()->value_.get(); }
+		bool operator==(iterator const& rhs) const
+		{
+			if (path_.empty() || rhs.path_.empty()) return path_.empty() == rhs.path_.empty();
+			return path_.back() == rhs.path_.back();
+		}
+		bool operator!=(iterator const& rhs) const { return !(*this == rhs); }
+
+		iterator& operator++()
+		{
+			node const* v = path_.back();
+			path_.pop_back();
+			push_leftmost(v->right_.get());
+			return *this;
+		}
+	private:
+		void push_leftmost(node const* v)
+		{
+			for (; v; v = v->left_.get()) path_.push_back(v);
+		}
+
+		// nodes whose entry has not been visited yet, current node on top
+		std::vector<node const*> path_;
+	};
+};
+
+}
\ No newline at end of file
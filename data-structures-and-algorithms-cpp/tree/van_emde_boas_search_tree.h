@@ -0,0 +1,137 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <algorithm>
+#include <cstddef>
+
+#include "utils/utils.h"
+
+namespace data_structures_cpp {
+
+/*
+ * static search tree over sorted keys laid out in van Emde Boas order: a tree of height h
+ * is cut at depth h/2 into a top tree and up to 2^(h/2) bottom trees, each stored
+ * contiguously and recursively laid out the same way. Any root to leaf path then touches
+ * O(log_B n) blocks for every block size B, without knowing B.
+ *
+ * Nodes are numbered like vector_binary_tree (children of v are 2v and 2v+1) and the tree
+ * has the shape of a complete binary tree of n nodes. Storage is reserved for the perfect
+ * tree of the same height, so up to n extra empty slots. The slot of a node is computed
+ * during the descent from per-depth tables, as described by Brodal, Fagerberg and Jacob.
+ */
+template <class K, class V>
+class van_emde_boas_search_tree
+{
+public:
+	using entry_t = key_value_pair<K, V>;
+	using key_type = typename entry_t::key_type;
+	using value_type = typename entry_t::value_type;
+
+	explicit van_emde_boas_search_tree() : size_(0) {}
+
+	explicit van_emde_boas_search_tree(std::vector<entry_t> entries) : size_(entries.size())
+	{
+		std::stable_sort(entries.begin(), entries.end(),
+			[](entry_t const& lhs, entry_t const& rhs) { return lhs.key_ < rhs.key_; });
+		std::size_t height = 0;
+		while ((std::size_t(1) << height) <= size_) ++height;
+		depths_.resize(height);
+		if (height > 0) split(0, height);
+
+		// slots of all nodes of the perfect tree, in bfs order
+		std::vector<std::size_t> slots(std::size_t(1) << height);
+		for (std::size_t v = 1, depth = 0; v < slots.size(); ++v)
+		{
+			if (v == (std::size_t(1) << (depth + 1))) ++depth;
+			slots[v] = depth == 0 ? 0 : slot(depth, v, slots[v >> (depth - depths_[depth].top_depth_)]);
+		}
+		keys_.resize(slots.size() - 1);
+		values_.resize(slots.size() - 1);
+		std::size_t next = 0;
+		build(1, entries, slots, next);
+	}
+
+	std::size_t size() const { return size_; }
+	bool empty() const { return size_ == 0; }
+
+	value_type const* find(key_type const& k) const
+	{
+		std::size_t s = lower_bound_slot(k);
+		if (s == npos || k < keys_[s]) return nullptr;
+		return &values_[s];
+	}
+
+	// first entry whose key is not less than k
+	std::optional<entry_t> lower_bound(key_type const& k) const
+	{
+		std::size_t s = lower_bound_slot(k);
+		if (s == npos) return std::nullopt;
+		return entry_t(keys_[s], values_[s]);
+	}
+
+protected:
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+	// layout of the recursive subtree whose root lies at a given depth
+	struct depth_layout
+	{
+		std::size_t top_size_{ 0 };		// nodes in the top tree this depth hangs from
+		std::size_t bottom_size_{ 0 };	// nodes in each bottom tree rooted at this depth
+		std::size_t top_depth_{ 0 };	// depth of the root of that top tree
+	};
+
+	void split(std::size_t top_depth, std::size_t height)
+	{
+		if (height <= 1) return;
+		std::size_t top_height = height / 2;
+		std::size_t bottom_height = height - top_height;
+		depth_layout& layout = depths_[top_depth + top_height];
+		layout.top_size_ = (std::size_t(1) << top_height) - 1;
+		layout.bottom_size_ = (std::size_t(1) << bottom_height) - 1;
+		layout.top_depth_ = top_depth;
+		split(top_depth, top_height);
+		split(top_depth + top_height, bottom_height);
+	}
+
+	// slot of node v at depth > 0 given the slot of the root of the top tree it hangs from
+	std::size_t slot(std::size_t depth, std::size_t v, std::size_t top_root_slot) const
+	{
+		depth_layout const& layout = depths_[depth];
+		return top_root_slot + layout.top_size_ + (v & layout.top_size_) * layout.bottom_size_;
+	}
+
+	void build(std::size_t v, std::vector<entry_t> const& entries, std::vector<std::size_t> const& slots, std::size_t& next)
+	{
+		if (v > size_) return;
+		build(2 * v, entries, slots, next);
+		keys_[slots[v]] = entries[next].key_;
+		values_[slots[v]] = entries[next].value_;
+		++next;
+		build(2 * v + 1, entries, slots, next);
+	}
+
+	std::size_t lower_bound_slot(key_type const& k) const
+	{
+		std::size_t path[64];
+		std::size_t result = npos;
+		std::size_t v = 1;
+		for (std::size_t depth = 0; v <= size_; ++depth)
+		{
+			std::size_t s = depth == 0 ? 0 : slot(depth, v, path[depths_[depth].top_depth_]);
+			path[depth] = s;
+			bool right = keys_[s] < k;
+			result = right ? result : s;
+			v = 2 * v + right;
+		}
+		return result;
+	}
+
+private:
+	std::size_t size_;
+	std::vector<depth_layout> depths_{};
+	std::vector<key_type> keys_{};
+	std::vector<value_type> values_{};
+};
+
+}
\ No newline at end of file
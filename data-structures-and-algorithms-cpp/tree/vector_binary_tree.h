@@ -1,20 +1,28 @@
 #pragma once
 
 #include <vector>
+#include <utility>
+#include <stdexcept>
 #include <cstddef>
 
-#include "vector_binary_tree_node.h"
+#include "vector_binary_tree_storage.h"
 #include "vector_binary_tree_position.h"
 
 namespace data_structures_cpp {
 
-template <typename T>
+/*
+ * binary tree addressed by heap indices, children of v are 2v and 2v+1.
+ * Storage decides how nodes are kept, see vector_binary_tree_storage.h:
+ * dense_node_storage suits near complete trees, sparse_node_storage any shape.
+ */
+template <typename T, typename Storage = dense_node_storage<T>>
 class vector_binary_tree
 {
-	using children_t = typename vector_binary_tree_position<T>::children_type;
-	using position_t = vector_binary_tree_position<T>;
-	using node_t = typename position_t::node_t;
+	using position_t = vector_binary_tree_position<T, Storage>;
+	using children_t = typename position_t::children_type;
 public:
+	using storage_t = Storage;
+
 	explicit vector_binary_tree() = default;
 
 	std::size_t size() const { return size_; }
@@ -28,19 +36,16 @@ public:
 
 	void add_root()
 	{
-		position_t root(1, tree_);
-		tree_.resize(2); // vector-based approach must have 2 elements, as root starts at index 1
-		tree_[root.v_].empty_ = false;
+		tree_.insert(1); // root starts at index 1
 		size_ = 1;
 	}
 
 	void expand_external(position_t const& p)
 	{
-		tree_.resize(p.right().v_ + 1);
 		if (!p.external()) throw std::runtime_error("vertice is not external");
 
-		tree_[p.left().v_].empty_ = false;
-		tree_[p.right().v_].empty_ = false;
+		tree_.insert(p.left().v_);
+		tree_.insert(p.right().v_);
 		size_ += 2;
 	}
 
@@ -50,30 +55,32 @@ public:
 
 		position_t above = below.parent();
 		position_t sibling = below.v_ == above.left().v_ ? above.right() : above.left();
-		std::size_t v = sibling.v_;
-		if (above.v_ == root().v_)
+
+		// the sibling's subtree moves up one level to take the place of above,
+		// gather it level by level along with its new indices before overwriting anything
+		std::vector<std::pair<std::size_t, std::size_t>> moves{ { sibling.v_, above.v_ } };
+		for (std::size_t i = 0; i < moves.size(); ++i)
 		{
-			tree_[1].value_ = *sibling;
-			sibling.v_ = 1;
+			std::size_t from = moves[i].first, to = moves[i].second;
+			if (tree_.contains(2 * from)) moves.push_back({ 2 * from, 2 * to });
+			if (tree_.contains(2 * from + 1)) moves.push_back({ 2 * from + 1, 2 * to + 1 });
 		}
-		else
+		std::vector<T> values{};
+		values.reserve(moves.size());
+		for (auto const& move : moves)
 		{
-			position_t grandparent = above.parent();
-			if (above.v_ == grandparent.left().v_)
-			{
-				tree_[grandparent.left().v_].value_ = *sibling;
-				sibling.v_ = grandparent.left().v_;
-			}
-			else
-			{
-				tree_[grandparent.right().v_].value_ = *sibling;
-				sibling.v_ = grandparent.right().v_;
-			}
+			values.push_back(tree_.at(move.first));
+			tree_.erase(move.first);
+		}
+		tree_.erase(below.v_);
+		tree_.erase(above.v_);
+		for (std::size_t i = 0; i < moves.size(); ++i)
+		{
+			tree_.insert(moves[i].second);
+			tree_.at(moves[i].second) = std::move(values[i]);
 		}
-		tree_[below.v_].empty_ = true;
-		tree_[v].empty_ = true;
 		size_ -= 2;
-		return sibling;
+		return position_t(above.v_, tree_);
 	}
 
 	children_t positions()
@@ -83,18 +90,18 @@ public:
 		return list;
 	}
 
+	storage_t const& storage() const { return tree_; }
+
 protected:
 	void preorder(position_t pos, children_t& positions) const
 	{
 		positions.push_back(pos);
-		if (pos.left().v_ < tree_.size() && !(tree_[pos.left().v_].empty_))		
-			preorder(pos.left(), positions);
-		if (pos.right().v_ < tree_.size() && !(tree_[pos.right().v_].empty_))	
-			preorder(pos.right(), positions);
+		if (tree_.contains(pos.left().v_))		preorder(pos.left(), positions);
+		if (tree_.contains(pos.right().v_))		preorder(pos.right(), positions);
 	}
 
 private:
-	std::vector<node_t> tree_{};
+	storage_t tree_{};
 	std::size_t size_{ 0 };
 };
 
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+#include "vector_binary_tree_node.h"
+
+namespace data_structures_cpp {
+
+/*
+ * node storages of vector_binary_tree, addressed by the 1-based heap index of a node.
+ * Reads never allocate, only insert may.
+ */
+
+/*
+ * contiguous array indexed by heap index, grows to the largest index inserted.
+ * Compact for complete trees, but a chain of depth d needs 2^d slots.
+ */
+template <typename T>
+class dense_node_storage
+{
+public:
+	using node_t = vector_binary_tree_node<T>;
+
+	bool contains(std::size_t v) const { return v < nodes_.size() && !nodes_[v].empty_; }
+	T& at(std::size_t v) { return nodes_[v].value_; }
+	T const& at(std::size_t v) const { return nodes_[v].value_; }
+
+	void insert(std::size_t v)
+	{
+		if (v >= nodes_.size()) nodes_.resize(v + 1);
+		nodes_[v].empty_ = false;
+	}
+
+	// the slot keeps its last value until it is inserted again
+	void erase(std::size_t v)
+	{
+		if (v < nodes_.size()) nodes_[v].empty_ = true;
+	}
+
+	std::size_t slots() const { return nodes_.capacity(); }
+	std::size_t memory_usage() const { return nodes_.capacity() * sizeof(node_t); }
+private:
+	std::vector<node_t> nodes_{};
+};
+
+/*
+ * hash table from heap index to value, memory is O(n) whatever the shape of the tree
+ */
+template <typename T>
+class sparse_node_storage
+{
+public:
+	bool contains(std::size_t v) const { return nodes_.find(v) != nodes_.end(); }
+	T& at(std::size_t v) { return nodes_.find(v)->second; }
+	T const& at(std::size_t v) const { return nodes_.find(v)->second; }
+	void insert(std::size_t v) { nodes_[v]; }
+	void erase(std::size_t v) { nodes_.erase(v); }
+
+	std::size_t slots() const { return nodes_.size(); }
+	// bucket array plus one heap allocated list node per entry
+	std::size_t memory_usage() const
+	{
+		return nodes_.bucket_count() * sizeof(void*)
+			+ nodes_.size() * (sizeof(typename map_t::value_type) + sizeof(void*) + sizeof(std::size_t));
+	}
+private:
+	using map_t = std::unordered_map<std::size_t, T>;
+	map_t nodes_{};
+};
+
+}
\ No newline at end of file
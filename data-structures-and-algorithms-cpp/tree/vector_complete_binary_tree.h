@@ -23,6 +23,7 @@ public:
 	position_t root() { return pos(1); }
 	position_t last() { return pos(size()); }
 	void add(T const& value) { return vector_.push_back(value); }
+	void add(T&& value) { return vector_.push_back(std::move(value)); }
 	void remove() { vector_.pop_back(); }
 	void swap(position_t const& p, position_t const& q) { std::swap(*p, *q); }
 protected:
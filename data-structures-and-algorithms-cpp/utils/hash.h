@@ -0,0 +1,192 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace data_structures_cpp {
+
+/*
+ * finalizer of murmur3, spreads every input bit over the whole word.
+ * std::hash of integers is often the identity, tables that keep only some of
+ * the bits of a hash (power of two bucket counts, control bytes) mix it first.
+ */
+inline std::size_t mix_hash(std::size_t h)
+{
+	std::uint64_t x = static_cast<std::uint64_t>(h);
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	return static_cast<std::size_t>(x);
+}
+
+/*
+ * hash of a key as used internally by a hash table, obtained once with hash_of(k)
+ * and passed back to find(k, h) or prefetch(h) to avoid hashing the key again
+ */
+struct precomputed_hash
+{
+	std::size_t value;
+};
+
+namespace detail {
+
+// 64 x 64 bit multiplication folded back to 64 bits
+inline std::uint64_t multiply_fold(std::uint64_t a, std::uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	std::uint64_t high;
+	std::uint64_t low = _umul128(a, b, &high);
+	return low ^ high;
+#else
+	std::uint64_t a_high = a >> 32, a_low = a & 0xffffffffull, b_high = b >> 32, b_low = b & 0xffffffffull;
+	std::uint64_t cross = (a_low * b_low >> 32) + (a_high * b_low & 0xffffffffull) + a_low * b_high;
+	std::uint64_t high = a_high * b_high + (a_high * b_low >> 32) + (cross >> 32);
+	return (a * b) ^ high;
+#endif
+}
+
+inline std::uint64_t read64(unsigned char const* p)
+{
+	std::uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline std::uint64_t read32(unsigned char const* p)
+{
+	std::uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+}
+
+/*
+ * full murmur3 finalizer, two rounds of multiply and xorshift.
+ * Every input bit affects every output bit, unlike mix_hash which is cheaper but weaker.
+ */
+inline std::uint64_t fmix64(std::uint64_t x)
+{
+	x ^= x >> 33;
+	x *= 0xff51afd7ed558ccdull;
+	x ^= x >> 33;
+	x *= 0xc4ceb9fe1a85ec53ull;
+	x ^= x >> 33;
+	return x;
+}
+
+/*
+ * hash of a byte string in the style of wyhash: 16 bytes at a time are folded in with one
+ * wide multiplication, the last 1 to 16 bytes are read with two possibly overlapping loads.
+ */
+inline std::size_t hash_bytes(void const* data, std::size_t length)
+{
+	std::uint64_t const p0 = 0xa0761d6478bd642full, p1 = 0xe7037ed1a0b428dbull, p2 = 0x8ebc6af09c88c6e3ull;
+	unsigned char const* p = static_cast<unsigned char const*>(data);
+	std::uint64_t seed = p0 ^ length;
+	std::size_t n = length;
+	for (; n > 16; n -= 16, p += 16) seed = detail::multiply_fold(detail::read64(p) ^ p1, detail::read64(p + 8) ^ seed);
+	std::uint64_t a = 0, b = 0;
+	if (n >= 8)
+	{
+		a = detail::read64(p);
+		b = detail::read64(p + n - 8);
+	}
+	else if (n >= 4)
+	{
+		a = detail::read32(p);
+		b = detail::read32(p + n - 4);
+	}
+	else if (n > 0)
+	{
+		a = (std::uint64_t(p[0]) << 16) | (std::uint64_t(p[n >> 1]) << 8) | p[n - 1];
+	}
+	return static_cast<std::size_t>(detail::multiply_fold(p2 ^ length, detail::multiply_fold(a ^ p1, b ^ seed)));
+}
+
+/*
+ * transparent hasher for string keys: tables using it can be searched with a
+ * std::string_view or a string literal without building a std::string
+ */
+struct transparent_string_hash
+{
+	using is_transparent = void;
+	using is_avalanching = void;
+	std::size_t operator()(std::string_view s) const { return hash_bytes(s.data(), s.size()); }
+};
+
+/*
+ * default hasher of the hash tables: fmix64 for integers and enums,
+ * hash_bytes for strings, std::hash for anything else
+ */
+template <class T, class = void>
+struct default_hash : std::hash<T> {};
+
+template <class T>
+struct default_hash<T, std::enable_if_t<std::is_integral<T>::value || std::is_enum<T>::value>>
+{
+	using is_avalanching = void;
+	std::size_t operator()(T v) const { return static_cast<std::size_t>(fmix64(static_cast<std::uint64_t>(v))); }
+};
+
+template <>
+struct default_hash<std::string> : transparent_string_hash {};
+
+template <>
+struct default_hash<std::string_view> : transparent_string_hash {};
+
+namespace detail {
+
+template <class Hasher, class = void>
+struct is_transparent : std::false_type {};
+
+template <class Hasher>
+struct is_transparent<Hasher, std::void_t<typename Hasher::is_transparent>> : std::true_type {};
+
+// hashers declaring is_avalanching already spread their bits, the tables use them unmixed
+template <class Hasher, class = void>
+struct is_avalanching : std::false_type {};
+
+template <class Hasher>
+struct is_avalanching<Hasher, std::void_t<typename Hasher::is_avalanching>> : std::true_type {};
+
+// type taken by lookups: any Q when the hasher is transparent, the key type otherwise
+template <bool Transparent>
+struct key_arg
+{
+	template <class K, class Q>
+	using type = K;
+};
+
+template <>
+struct key_arg<true>
+{
+	template <class K, class Q>
+	using type = Q;
+};
+
+}
+
+/*
+ * hash of k as used by the hash tables, mixed unless Hasher avalanches on its own
+ */
+template <class Hasher, class Q>
+std::size_t table_hash(Hasher const& hasher, Q const& k)
+{
+	if constexpr (detail::is_avalanching<Hasher>::value) return hasher(k);
+	else return mix_hash(hasher(k));
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <xmmintrin.h>
+#endif
+
+namespace data_structures_cpp {
+
+/*
+ * hint the cpu to bring the cache line holding p into all cache levels,
+ * prefetching never faults so p may point anywhere
+ */
+inline void prefetch(void const* p)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	__builtin_prefetch(p);
+#elif defined(_MSC_VER)
+	_mm_prefetch(static_cast<char const*>(p), _MM_HINT_T0);
+#else
+	(void)p;
+#endif
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <cstddef>
+
+namespace data_structures_cpp {
+
+// upper bound on the number of threads alive at once that use per-thread slots
+constexpr std::size_t max_thread_count = 256;
+
+/*
+ * hands out small dense indices to threads, an index is recycled once its thread exits
+ * so containers can keep per-thread state in a fixed array indexed by this_thread_index()
+ */
+class thread_index_registry
+{
+public:
+	static thread_index_registry& instance()
+	{
+		static thread_index_registry registry{};
+		return registry;
+	}
+
+	std::size_t acquire()
+	{
+		for (std::size_t i = 0; i < max_thread_count; ++i)
+		{
+			bool expected = false;
+			if (!in_use_[i].load() && in_use_[i].compare_exchange_strong(expected, true))
+			{
+				std::size_t b = bound_.load();
+				while (b < i + 1 && !bound_.compare_exchange_weak(b, i + 1)) {}
+				return i;
+			}
+		}
+		throw std::runtime_error("more than max_thread_count threads are alive");
+	}
+
+	void release(std::size_t index) { in_use_[index].store(false); }
+
+	// every index handed out so far is less than bound()
+	std::size_t bound() const { return bound_.load(); }
+
+private:
+	thread_index_registry() = default;
+
+	std::atomic<bool> in_use_[max_thread_count]{};
+	std::atomic<std::size_t> bound_{ 0 };
+};
+
+// index of the calling thread, unique among the threads currently alive
+inline std::size_t this_thread_index()
+{
+	struct holder
+	{
+		holder() : index_(thread_index_registry::instance().acquire()) {}
+		~holder() { thread_index_registry::instance().release(index_); }
+		std::size_t const index_;
+	};
+	thread_local holder h{};
+	return h.index_;
+}
+
+}
\ No newline at end of file
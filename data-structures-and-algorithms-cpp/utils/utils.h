@@ -3,8 +3,17 @@
 namespace data_structures_cpp {
 
 template <class K, class V, class Entry> class binary_search_tree;
-template <class T, class U, class Hasher> class separate_chaining_hash_table;
+template <class T, class U, class Hasher, class Rehash> class separate_chaining_hash_table;
 template <class T, class U, class Hasher> class dictionary;
+template <class T, class U, class Hasher> class contiguous_dictionary;
+template <class T, class U, class Hasher> class swiss_hash_table;
+template <class T, class U, class Hasher> class robin_hood_hash_table;
+template <class T, class U, class Hasher> class cuckoo_hash_table;
+template <class T, class U, class Hasher> class static_perfect_hash_map;
+template <class K, class V> class persistent_avl_tree;
+template <class K, class V, int MaxLevel> class concurrent_skip_list_map;
+template <class K, class V> class eytzinger_search_tree;
+template <class K, class V> class van_emde_boas_search_tree;
 template <class K, class V> struct key_value_pair;
 
 template <class K, class V>
@@ -24,10 +33,28 @@ struct key_value_pair
 private:
 	template <class T, class U, class E>
 	friend class binary_search_tree;
-	template <class T, class U, class Hasher>
+	template <class T, class U, class Hasher, class Rehash>
 	friend class separate_chaining_hash_table;
 	template <class T, class U, class Hasher>
 	friend class dictionary;
+	template <class T, class U, class Hasher>
+	friend class contiguous_dictionary;
+	template <class T, class U, class Hasher>
+	friend class swiss_hash_table;
+	template <class T, class U, class Hasher>
+	friend class robin_hood_hash_table;
+	template <class T, class U, class Hasher>
+	friend class cuckoo_hash_table;
+	template <class T, class U, class Hasher>
+	friend class static_perfect_hash_map;
+	template <class T, class U>
+	friend class persistent_avl_tree;
+	template <class T, class U, int MaxLevel>
+	friend class concurrent_skip_list_map;
+	template <class T, class U>
+	friend class eytzinger_search_tree;
+	template <class T, class U>
+	friend class van_emde_boas_search_tree;
 	key_type key_;
 	value_type value_;
 };
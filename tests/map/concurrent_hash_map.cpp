@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+
+#include "map/concurrent_hash_map.h"
+
+TEST_CASE("concurrent_hash_map read/write is coherent", "[concurrent_hash_map]")
+{
+	SECTION("given an empty concurrent_hash_map")
+	{
+		data_structures_cpp::concurrent_hash_map<std::string, std::string, std::hash<std::string>> map{ 10 };
+		REQUIRE(map.shard_count() == 16);
+		REQUIRE(map.empty());
+		REQUIRE_FALSE(map.find("i am minh"));
+		SECTION("inserting 'i am minh','a vietnamese' and 'i am afsa','a persian'")
+		{
+			REQUIRE(map.insert("i am minh", "a vietnamese"));
+			REQUIRE(map.insert("i am afsa", "a persian"));
+			SECTION("yields size() == 2")
+			{
+				REQUIRE(map.size() == 2);
+				REQUIRE_FALSE(map.empty());
+			}
+			SECTION("offers correct accessing methods")
+			{
+				REQUIRE(*map.find("i am minh") == "a vietnamese");
+				REQUIRE(*map.find("i am afsa") == "a persian");
+				REQUIRE(map.contains("i am afsa"));
+			}
+			SECTION("inserting a duplicate key fails, putting it overwrites")
+			{
+				REQUIRE_FALSE(map.insert("i am minh", "a canadian"));
+				REQUIRE(*map.find("i am minh") == "a vietnamese");
+				map.put("i am minh", "a canadian");
+				REQUIRE(*map.find("i am minh") == "a canadian");
+				REQUIRE(map.size() == 2);
+			}
+			SECTION("erasing 'i am minh'")
+			{
+				REQUIRE(map.erase("i am minh"));
+				REQUIRE_FALSE(map.erase("i am minh"));
+				REQUIRE(map.size() == 1);
+				int visited = 0;
+				map.for_each([&](std::string const& k, std::string const& v) { visited += k == "i am afsa" && v == "a persian"; });
+				REQUIRE(visited == 1);
+			}
+		}
+	}
+}
+
+TEST_CASE("concurrent_hash_map is coherent under concurrent readers and writers", "[concurrent_hash_map]")
+{
+	data_structures_cpp::concurrent_hash_map<int, int, std::hash<int>> map{ 8 };
+	// even keys are stable, odd keys are inserted, overwritten and erased concurrently
+	for (int k = 0; k < 20000; k += 2) map.insert(k, k);
+
+	std::atomic<bool> done{ false };
+	std::atomic<int> errors{ 0 };
+	std::vector<std::thread> threads{};
+	for (int w = 0; w < 2; ++w)
+	{
+		threads.emplace_back([&, w]() {
+			for (int round = 0; round < 5; ++round)
+			{
+				for (int k = 1 + 2 * w; k < 20000; k += 4) if (!map.insert(k, k)) ++errors;
+				for (int k = 1 + 2 * w; k < 20000; k += 4) map.put(k, -k);
+				for (int k = 1 + 2 * w; k < 20000; k += 4) if (!map.erase(k)) ++errors;
+			}
+		});
+	}
+	for (int r = 0; r < 3; ++r)
+	{
+		threads.emplace_back([&]() {
+			while (!done)
+			{
+				for (int k = 0; k < 20000; ++k)
+				{
+					auto value = map.find(k);
+					if (k % 2 == 0 && (!value || *value != k)) ++errors;
+					if (k % 2 == 1 && value && *value != k && *value != -k) ++errors;
+				}
+				long long stable = 0;
+				map.for_each([&](int k, int v) { if (k % 2 == 0) stable += v == k; });
+				if (stable != 10000) ++errors;
+			}
+		});
+	}
+	threads[0].join();
+	threads[1].join();
+	done = true;
+	for (std::size_t t = 2; t < threads.size(); ++t) threads[t].join();
+
+	REQUIRE(errors == 0);
+	REQUIRE(map.size() == 10000);
+	for (int k = 1; k < 20000; k += 2) REQUIRE_FALSE(map.contains(k));
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "map/concurrent_skip_list_map.h"
+
+TEST_CASE("concurrent_skip_list_map read/write is coherent", "[concurrent_skip_list_map]")
+{
+	SECTION("given an empty concurrent_skip_list_map")
+	{
+		data_structures_cpp::concurrent_skip_list_map<std::string, std::string> map{};
+		REQUIRE(map.empty());
+		REQUIRE(map.size() == 0);
+		REQUIRE_FALSE(map.find("i am minh"));
+		REQUIRE_FALSE(map.lower_bound(""));
+		SECTION("inserting 'i am minh','a vietnamese' and 'i am afsa','a persian'")
+		{
+			REQUIRE(map.insert("i am minh", "a vietnamese"));
+			REQUIRE(map.insert("i am afsa", "a persian"));
+			SECTION("yields size() == 2")
+			{
+				REQUIRE(map.size() == 2);
+				REQUIRE_FALSE(map.empty());
+			}
+			SECTION("offers correct accessing methods")
+			{
+				REQUIRE(map.contains("i am minh"));
+				REQUIRE(*map.find("i am minh") == "a vietnamese");
+				REQUIRE(*map.find("i am afsa") == "a persian");
+				REQUIRE(map.lower_bound("i am b")->key() == "i am minh");
+				REQUIRE(map.lower_bound("i am afsa")->value() == "a persian");
+				REQUIRE_FALSE(map.lower_bound("i am n"));
+			}
+			SECTION("inserting a duplicate key fails and keeps the first value")
+			{
+				REQUIRE_FALSE(map.insert("i am minh", "a canadian"));
+				REQUIRE(*map.find("i am minh") == "a vietnamese");
+				REQUIRE(map.size() == 2);
+			}
+			SECTION("erasing 'i am minh'")
+			{
+				REQUIRE(map.erase("i am minh"));
+				REQUIRE_FALSE(map.erase("i am minh"));
+				SECTION("yields size() == 1 and no more 'i am minh'")
+				{
+					REQUIRE(map.size() == 1);
+					REQUIRE_FALSE(map.contains("i am minh"));
+					REQUIRE_FALSE(map.lower_bound("i am b"));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("concurrent_skip_list_map is coherent under concurrent readers and writers", "[concurrent_skip_list_map]")
+{
+	data_structures_cpp::concurrent_skip_list_map<int, int> map{};
+	// even keys are stable, odd keys are inserted and erased concurrently
+	for (int k = 0; k < 2000; k += 2) map.insert(k, k);
+
+	std::atomic<bool> done{ false };
+	std::atomic<int> errors{ 0 };
+	std::vector<std::thread> threads{};
+	for (int w = 0; w < 2; ++w)
+	{
+		threads.emplace_back([&, w]() {
+			for (int round = 0; round < 20; ++round)
+			{
+				for (int k = 1 + 2 * w; k < 2000; k += 4) if (!map.insert(k, k)) ++errors;
+				for (int k = 1 + 2 * w; k < 2000; k += 4) if (!map.erase(k)) ++errors;
+			}
+		});
+	}
+	for (int r = 0; r < 4; ++r)
+	{
+		threads.emplace_back([&]() {
+			while (!done)
+			{
+				for (int k = 0; k < 2000; k += 2)
+				{
+					auto value = map.find(k);
+					if (!value || *value != k) ++errors;
+					if (k + 2 == 2000) continue;
+					auto next = map.lower_bound(k + 1);
+					if (!next || next->key() <= k || next->key() > k + 2) ++errors;
+				}
+			}
+		});
+	}
+	threads[0].join();
+	threads[1].join();
+	done = true;
+	for (std::size_t t = 2; t < threads.size(); ++t) threads[t].join();
+
+	REQUIRE(errors == 0);
+	REQUIRE(map.size() == 1000);
+	for (int k = 1; k < 2000; k += 2) REQUIRE_FALSE(map.contains(k));
+}
+
+TEST_CASE("concurrent_skip_list_map frees erased nodes while readers keep running", "[concurrent_skip_list_map]")
+{
+	data_structures_cpp::concurrent_skip_list_map<int, int> map{};
+	for (int k = 0; k < 1000; ++k) map.insert(k, k);
+
+	std::atomic<bool> done{ false };
+	std::vector<std::thread> readers{};
+	for (int r = 0; r < 4; ++r)
+	{
+		readers.emplace_back([&]() {
+			while (!done) for (int k = 0; k < 1000; ++k) map.find(k);
+		});
+	}
+
+	// every key is erased and reinserted many times over while readers never stop
+	std::size_t max_retired = 0;
+	for (int round = 0; round < 20; ++round)
+	{
+		for (int k = 0; k < 1000; ++k)
+		{
+			REQUIRE(map.erase(k));
+			REQUIRE(map.insert(k, k));
+		}
+		std::size_t retired = map.retired_count();
+		if (retired > max_retired) max_retired = retired;
+	}
+	done = true;
+	for (auto& reader : readers) reader.join();
+
+	// waiting for the map to be quiescent would keep all 20000 erased nodes
+	REQUIRE(max_retired < 10000);
+	REQUIRE(map.size() == 1000);
+
+	// without concurrent operations two more erases move past the epochs of every retired node
+	map.erase(0);
+	map.erase(1);
+	REQUIRE(map.retired_count() <= 2);
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <numeric>
+#include <functional>
+
+#include "map/contiguous_dictionary.h"
+
+TEST_CASE("contiguous_dictionary read/write is coherent", "[contiguous_dictionary]")
+{
+	SECTION("given an empty contiguous_dictionary")
+	{
+		data_structures_cpp::contiguous_dictionary<std::string, std::string, std::hash<std::string>> table{};
+		REQUIRE(table.empty());
+		REQUIRE(table.size() == 0);
+		REQUIRE(table.find_all("i am afsa").empty());
+		SECTION("inserting 'i am minh','a vietnamese' and three values for 'i am afsa'")
+		{
+			table.insert("i am minh", "a vietnamese");
+			table.insert("i am afsa", "a persian");
+			table.insert("i am afsa", "minh's boyfriend");
+			table.insert("i am afsa", "ahzeen's sister");
+			SECTION("yields size() == 4 over 2 keys")
+			{
+				REQUIRE(table.size() == 4);
+				REQUIRE(table.key_count() == 2);
+				REQUIRE(table.count("i am afsa") == 3);
+			}
+			SECTION("find_all returns the values of a key contiguously in insertion order")
+			{
+				auto range = table.find_all("i am afsa");
+				REQUIRE(range.size() == 3);
+				REQUIRE(range[0] == "a persian");
+				REQUIRE(range[1] == "minh's boyfriend");
+				REQUIRE(range[2] == "ahzeen's sister");
+				REQUIRE(range.end() - range.begin() == 3);
+				REQUIRE(table.find_all("i am minh")[0] == "a vietnamese");
+			}
+			SECTION("erase_all('i am afsa') removes all its values")
+			{
+				table.erase_all("i am afsa");
+				REQUIRE(table.size() == 1);
+				REQUIRE(table.key_count() == 1);
+				REQUIRE(table.find_all("i am afsa").empty());
+				REQUIRE_THROWS(table.erase_all("i am afsa"));
+				REQUIRE((*table.begin()).key() == "i am minh");
+			}
+		}
+	}
+}
+
+TEST_CASE("contiguous_dictionary holds keys with thousands of values", "[contiguous_dictionary]")
+{
+	data_structures_cpp::contiguous_dictionary<int, int, std::hash<int>> table{ 1 };
+	for (int v = 0; v < 5000; ++v)
+	{
+		for (int k = 0; k < 10; ++k) table.insert(k, k * v);
+	}
+	REQUIRE(table.size() == 50000);
+	REQUIRE(table.key_count() == 10);
+	for (int k = 0; k < 10; ++k)
+	{
+		auto range = table.find_all(k);
+		REQUIRE(range.size() == 5000);
+		REQUIRE(std::accumulate(range.begin(), range.end(), 0ll) == k * (4999ll * 5000 / 2));
+	}
+}
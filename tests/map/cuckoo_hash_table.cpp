@@ -0,0 +1,164 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <algorithm>
+
+#include "map/cuckoo_hash_table.h"
+
+TEST_CASE("cuckoo_hash_table read/write is coherent", "[cuckoo_hash_table]")
+{
+	SECTION("given an empty cuckoo_hash_table")
+	{
+		data_structures_cpp::cuckoo_hash_table<std::string, std::string, std::hash<std::string>> table{};
+		REQUIRE(table.empty());
+		REQUIRE(table.size() == 0);
+		REQUIRE(table.begin() == table.end());
+		REQUIRE(table.find("i am minh") == table.end());
+		SECTION("putting elements 'i am minh','a vietnamese' and 'i am afsa','a persian'")
+		{
+			table.put("i am minh", "a vietnamese");
+			table.put("i am afsa", "a persian");
+			SECTION("yields size() == 2")
+			{
+				REQUIRE(table.size() == 2);
+				REQUIRE_FALSE(table.empty());
+			}
+			SECTION("offers correct accessing methods")
+			{
+				REQUIRE(table.find("i am minh")->key() == "i am minh");
+				REQUIRE(table.find("i am minh")->value() == "a vietnamese");
+				REQUIRE(table.find("i am afsa")->value() == "a persian");
+			}
+			SECTION("putting an existing key overwrites its value")
+			{
+				table.put("i am minh", "a canadian");
+				REQUIRE(table.size() == 2);
+				REQUIRE(table.find("i am minh")->value() == "a canadian");
+			}
+			SECTION("erasing 'i am minh','a vietnamese'")
+			{
+				table.erase(table.find("i am minh"));
+				SECTION("yields size() == 1")
+				{
+					REQUIRE(table.size() == 1);
+					REQUIRE(table.find("i am minh") == table.end());
+					REQUIRE_THROWS(table.erase("i am minh"));
+				}
+				SECTION("yields begin() is 'i am afsa','a persian'")
+				{
+					REQUIRE(*table.begin() == data_structures_cpp::key_value_pair<const std::string, std::string>("i am afsa", "a persian"));
+					REQUIRE(++table.begin() == table.end());
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("cuckoo_hash_table grows and reuses erased slots", "[cuckoo_hash_table]")
+{
+	data_structures_cpp::cuckoo_hash_table<int, int, std::hash<int>> table{};
+	std::unordered_map<int, int> reference{};
+	for (int round = 0; round < 4; ++round)
+	{
+		for (int k = 0; k < 5000; ++k)
+		{
+			table.put(k * 7 + round, k);
+			reference[k * 7 + round] = k;
+		}
+		for (int k = 0; k < 5000; k += 2)
+		{
+			table.erase(k * 7 + round);
+			reference.erase(k * 7 + round);
+		}
+	}
+	REQUIRE(table.size() == reference.size());
+	REQUIRE(table.capacity() >= table.size());
+	for (auto const& kv : reference)
+	{
+		auto it = table.find(kv.first);
+		REQUIRE(it != table.end());
+		REQUIRE(it->value() == kv.second);
+	}
+	std::size_t iterated = 0;
+	for (auto it = table.begin(); it != table.end(); ++it, ++iterated)
+	{
+		REQUIRE(reference.count(it->key()) == 1);
+	}
+	REQUIRE(iterated == reference.size());
+	REQUIRE(table.find(-1) == table.end());
+
+	SECTION("reserve avoids rehashing while filling")
+	{
+		data_structures_cpp::cuckoo_hash_table<int, int, std::hash<int>> reserved{};
+		reserved.reserve(1000);
+		std::size_t capacity = reserved.capacity();
+		for (int k = 0; k < 1000; ++k) reserved.put(k, k);
+		REQUIRE(reserved.capacity() == capacity);
+	}
+}
+
+namespace {
+
+// sends every key to the same buckets
+struct constant_hash
+{
+	std::size_t operator()(int) const { return 42; }
+};
+
+// distinct hashes sharing their low 8 bits and their tag, only a wide bucket mask tells them apart
+struct shifted_hash
+{
+	using is_avalanching = void;
+	std::size_t operator()(int k) const { return static_cast<std::size_t>(k) << 8; }
+};
+
+}
+
+TEST_CASE("cuckoo_hash_table keeps every key in one of its two buckets", "[cuckoo_hash_table]")
+{
+	SECTION("tables fill up to high loads before growing")
+	{
+		data_structures_cpp::cuckoo_hash_table<int, int, std::hash<int>> table{};
+		std::size_t max_load_percent = 0;
+		for (int k = 0; k < 100000; ++k)
+		{
+			std::size_t capacity = table.capacity();
+			std::size_t size = table.size();
+			table.put(k, k);
+			if (table.capacity() != capacity) max_load_percent = std::max(max_load_percent, 100 * size / capacity);
+		}
+		REQUIRE(max_load_percent >= 90);
+		bool all_found = true;
+		for (int k = 0; k < 100000; ++k) all_found = all_found && table.find(k) != table.end() && table.find(k)->value() == k;
+		REQUIRE(all_found);
+	}
+	SECTION("keys sharing their whole hash are refused once their buckets are full")
+	{
+		data_structures_cpp::cuckoo_hash_table<int, int, constant_hash> table{};
+		for (int k = 0; k < 8; ++k) table.put(k, k);
+		std::size_t capacity = table.capacity();
+		REQUIRE_THROWS(table.put(8, 8));
+		REQUIRE(table.capacity() == capacity);
+		REQUIRE(table.size() == 8);
+		for (int i = 0; i < 8; ++i) REQUIRE(table.find(i)->value() == i);
+		REQUIRE(table.find(8) == table.end());
+	}
+	SECTION("keys sharing their home bits and tag but not their whole hash are all accepted")
+	{
+		data_structures_cpp::cuckoo_hash_table<int, int, shifted_hash> table{};
+		for (int k = 1; k <= 100; ++k) table.put(k, -k);
+		REQUIRE(table.size() == 100);
+		bool all_found = true;
+		for (int k = 1; k <= 100; ++k) all_found = all_found && table.find(k) != table.end() && table.find(k)->value() == -k;
+		REQUIRE(all_found);
+	}
+}
+
+TEST_CASE("cuckoo_hash_table never needs more than two probes", "[cuckoo_hash_table]")
+{
+	data_structures_cpp::cuckoo_hash_table<int, int> table{};
+	for (int k = 0; k < 10000; ++k) table.put(k, k);
+	REQUIRE(table.statistics().max_probe_length <= 2);
+}
\ No newline at end of file
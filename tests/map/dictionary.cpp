@@ -73,7 +73,32 @@ TEST_CASE("dictionary read/write is coherent", "[dictionary]")
 					++it;
 					REQUIRE(it == range.end());
 				}
+				SECTION("duplicates stay adjacent once the table grows")
+				{
+					for (int i = 0; i < 1000; ++i) table.put(std::to_string(i), "filler");
+					REQUIRE(table.bucket_count() >= 1000);
+					auto range = table.find_all("i am afsa");
+					int i = 0;
+					for (auto it = range.begin(); it != range.end(); ++it) ++i;
+					REQUIRE(i == 3);
+				}
 			}
 		}
 	}
+}
+
+TEST_CASE("dictionary with a filter keeps duplicates together", "[dictionary]")
+{
+	data_structures_cpp::dictionary<int, int> table{ 1 };
+	table.enable_filter();
+	for (int i = 0; i < 3000; ++i) table.insert(i % 1000, i);
+	bool all_right = true;
+	for (int k = 0; k < 2000; ++k)
+	{
+		auto range = table.find_all(k);
+		int n = 0;
+		for (auto it = range.begin(); it != range.end(); ++it) all_right = all_right && (*it).key() == k && ++n;
+		all_right = all_right && n == (k < 1000 ? 3 : 0);
+	}
+	REQUIRE(all_right);
 }
\ No newline at end of file
@@ -0,0 +1,62 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <cstddef>
+#include <string_view>
+
+#include "map/separate_chaining_hash_table.h"
+#include "map/swiss_hash_table.h"
+#include "map/robin_hood_hash_table.h"
+#include "map/cuckoo_hash_table.h"
+
+TEMPLATE_TEST_CASE("hash tables support heterogeneous and precomputed hash lookups", "[hash_tables]",
+	(data_structures_cpp::separate_chaining_hash_table<std::string, int, data_structures_cpp::transparent_string_hash>),
+	(data_structures_cpp::swiss_hash_table<std::string, int, data_structures_cpp::transparent_string_hash>),
+	(data_structures_cpp::robin_hood_hash_table<std::string, int, data_structures_cpp::transparent_string_hash>),
+	(data_structures_cpp::cuckoo_hash_table<std::string, int, data_structures_cpp::transparent_string_hash>))
+{
+	TestType table{};
+	for (int i = 0; i < 1000; ++i) table.put(std::to_string(i), i);
+	SECTION("keys can be looked up and erased through a std::string_view")
+	{
+		std::string_view key = "42";
+		auto it = table.find(key);
+		REQUIRE(it != table.end());
+		REQUIRE((*it).value() == 42);
+		REQUIRE(table.find(std::string_view("1000")) == table.end());
+		table.erase(key);
+		REQUIRE(table.find(key) == table.end());
+		REQUIRE(table.size() == 999);
+	}
+	SECTION("a hash computed once serves prefetch and find")
+	{
+		bool all_found = true;
+		for (int i = 0; i < 2000; ++i)
+		{
+			std::string key = std::to_string(i);
+			auto h = table.hash_of(key);
+			REQUIRE(h.value == table.hash_of(std::string_view(key)).value);
+			table.prefetch(h);
+			auto it = table.find(key, h);
+			all_found = all_found && (i < 1000 ? it != table.end() && (*it).value() == i : it == table.end());
+		}
+		REQUIRE(all_found);
+	}
+}
+
+TEMPLATE_TEST_CASE("open addressing hash tables statistics account for every entry", "[hash_tables]",
+	(data_structures_cpp::swiss_hash_table<int, int>),
+	(data_structures_cpp::robin_hood_hash_table<int, int>),
+	(data_structures_cpp::cuckoo_hash_table<int, int>))
+{
+	TestType table{};
+	for (int k = 0; k < 10000; ++k) table.put(k, k);
+	auto stats = table.statistics();
+	std::size_t entries = 0;
+	for (std::size_t count : stats.probe_length_histogram) entries += count;
+	REQUIRE(stats.size == 10000);
+	REQUIRE(entries == 10000);
+	REQUIRE(stats.max_probe_length == stats.probe_length_histogram.size());
+	REQUIRE(stats.mean_probe_length >= 1);
+	REQUIRE(stats.collision_rate < 0.5);
+}
\ No newline at end of file
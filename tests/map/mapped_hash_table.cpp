@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include "map/mapped_hash_table.h"
+#include "map/separate_chaining_hash_table.h"
+
+namespace {
+
+struct point
+{
+	std::int32_t x_;
+	std::int32_t y_;
+	bool operator==(point const& rhs) const { return x_ == rhs.x_ && y_ == rhs.y_; }
+};
+
+char const* const image_path = "mapped_hash_table_test.bin";
+
+// overwrites length bytes of the file at path, starting at offset
+void patch(char const* path, std::size_t offset, void const* bytes, std::size_t length)
+{
+	std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+	file.seekp(static_cast<std::streamoff>(offset));
+	file.write(static_cast<char const*>(bytes), static_cast<std::streamsize>(length));
+}
+
+}
+
+TEST_CASE("mapped_hash_table serves lookups from a written image", "[mapped_hash_table]")
+{
+	using table_t = data_structures_cpp::mapped_hash_table<std::uint64_t, point>;
+	using writer_t = data_structures_cpp::mapped_hash_table_writer<std::uint64_t, point>;
+	SECTION("given an image of 10000 entries")
+	{
+		{
+			writer_t writer(image_path, 10000);
+			for (std::uint64_t k = 0; k < 10000; ++k) writer.put(k * 7919, point{ static_cast<std::int32_t>(k), -1 });
+			REQUIRE(writer.size() == 10000);
+			writer.finish();
+		}
+		table_t table(image_path);
+		SECTION("loading yields the written size and every value")
+		{
+			REQUIRE(table.size() == 10000);
+			REQUIRE(table.capacity() * 3 / 4 >= table.size());
+			for (std::uint64_t k = 0; k < 10000; ++k)
+			{
+				REQUIRE(table.find(k * 7919) != nullptr);
+				REQUIRE(*table.find(k * 7919) == point{ static_cast<std::int32_t>(k), -1 });
+			}
+		}
+		SECTION("missing keys are not found")
+		{
+			for (std::uint64_t k = 0; k < 10000; ++k) REQUIRE_FALSE(table.contains(k * 7919 + 1));
+		}
+		SECTION("lookups with a precomputed hash agree")
+		{
+			auto h = table.hash_of(7919);
+			table.prefetch(h);
+			REQUIRE(table.find(7919, h)->x_ == 1);
+		}
+		SECTION("for_each visits every entry once and statistics account for them")
+		{
+			std::size_t visited = 0;
+			table.for_each([&](std::uint64_t k, point const& p) { visited += k == static_cast<std::uint64_t>(p.x_) * 7919; });
+			REQUIRE(visited == 10000);
+			auto stats = table.statistics();
+			REQUIRE(stats.size == 10000);
+			REQUIRE(stats.mean_probe_length < 4);
+		}
+	}
+	SECTION("putting an existing key overwrites its value without counting it twice")
+	{
+		{
+			writer_t writer(image_path, 1);
+			writer.put(42, point{ 1, 1 });
+			writer.put(42, point{ 2, 2 });
+			REQUIRE_THROWS_AS(writer.put(43, point{ 3, 3 }), std::runtime_error);
+			writer.finish();
+		}
+		table_t table(image_path);
+		REQUIRE(table.size() == 1);
+		REQUIRE(*table.find(42) == point{ 2, 2 });
+	}
+	SECTION("an empty image loads as an empty table")
+	{
+		writer_t(image_path, 0).finish();
+		table_t table(image_path);
+		REQUIRE(table.empty());
+		REQUIRE(table.find(0) == nullptr);
+	}
+	SECTION("any table can be saved")
+	{
+		data_structures_cpp::separate_chaining_hash_table<std::uint64_t, std::uint64_t> source{};
+		for (std::uint64_t k = 0; k < 1000; ++k) source.put(k, k * k);
+		data_structures_cpp::save_mapped_hash_table<std::uint64_t, std::uint64_t>(image_path, source);
+		data_structures_cpp::mapped_hash_table<std::uint64_t, std::uint64_t> table(image_path);
+		REQUIRE(table.size() == 1000);
+		for (std::uint64_t k = 0; k < 1000; ++k) REQUIRE(*table.find(k) == k * k);
+	}
+	std::remove(image_path);
+}
+
+TEST_CASE("mapped_hash_table lookups terminate on an image without empty slots", "[mapped_hash_table]")
+{
+	using table_t = data_structures_cpp::mapped_hash_table<std::uint64_t, std::uint64_t>;
+	{
+		data_structures_cpp::mapped_hash_table_writer<std::uint64_t, std::uint64_t> writer(image_path, 10);
+		writer.put(1, 1);
+		writer.finish();
+	}
+	// every control byte marked full while the header still counts a single entry
+	std::size_t const capacity = table_t(image_path).capacity();
+	std::vector<unsigned char> full(capacity, 0xff);
+	patch(image_path, sizeof(data_structures_cpp::detail::mapped_hash_table_header), full.data(), full.size());
+	table_t table(image_path);
+	REQUIRE(table.find(2) == nullptr);
+	std::remove(image_path);
+}
+
+TEST_CASE("mapped_hash_table refuses invalid images", "[mapped_hash_table]")
+{
+	using table_t = data_structures_cpp::mapped_hash_table<std::uint64_t, std::uint64_t>;
+	using writer_t = data_structures_cpp::mapped_hash_table_writer<std::uint64_t, std::uint64_t>;
+	SECTION("a missing file")
+	{
+		std::remove(image_path);
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	SECTION("an empty file")
+	{
+		std::ofstream(image_path).close();
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	SECTION("an unfinished image")
+	{
+		{
+			writer_t writer(image_path, 10);
+			writer.put(1, 1);
+		}
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	SECTION("an image of another entry type")
+	{
+		data_structures_cpp::mapped_hash_table_writer<std::uint64_t, std::uint32_t>(image_path, 10).finish();
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	SECTION("a truncated image")
+	{
+		writer_t(image_path, 1000).finish();
+		REQUIRE(truncate(image_path, 4096) == 0);
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	SECTION("an image claiming as many entries as slots")
+	{
+		writer_t(image_path, 10).finish();
+		std::uint64_t const size = table_t(image_path).capacity();
+		patch(image_path, offsetof(data_structures_cpp::detail::mapped_hash_table_header, size_), &size, sizeof(size));
+		REQUIRE_THROWS_AS(table_t(image_path), std::runtime_error);
+	}
+	std::remove(image_path);
+}
\ No newline at end of file
@@ -0,0 +1,129 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <functional>
+#include <unordered_map>
+
+#include "map/robin_hood_hash_table.h"
+
+TEST_CASE("robin_hood_hash_table read/write is coherent", "[robin_hood_hash_table]")
+{
+	SECTION("given an empty robin_hood_hash_table")
+	{
+		data_structures_cpp::robin_hood_hash_table<std::string, std::string, std::hash<std::string>> table{};
+		REQUIRE(table.empty());
+		REQUIRE(table.size() == 0);
+		REQUIRE(table.begin() == table.end());
+		REQUIRE(table.find("i am minh") == table.end());
+		SECTION("putting elements 'i am minh','a vietnamese' and 'i am afsa','a persian'")
+		{
+			table.put("i am minh", "a vietnamese");
+			table.put("i am afsa", "a persian");
+			SECTION("yields size() == 2")
+			{
+				REQUIRE(table.size() == 2);
+				REQUIRE_FALSE(table.empty());
+			}
+			SECTION("offers correct accessing methods")
+			{
+				REQUIRE(table.find("i am minh")->key() == "i am minh");
+				REQUIRE(table.find("i am minh")->value() == "a vietnamese");
+				REQUIRE(table.find("i am afsa")->value() == "a persian");
+			}
+			SECTION("putting an existing key overwrites its value")
+			{
+				table.put("i am minh", "a canadian");
+				REQUIRE(table.size() == 2);
+				REQUIRE(table.find("i am minh")->value() == "a canadian");
+			}
+			SECTION("erasing 'i am minh','a vietnamese'")
+			{
+				table.erase(table.find("i am minh"));
+				SECTION("yields size() == 1")
+				{
+					REQUIRE(table.size() == 1);
+					REQUIRE(table.find("i am minh") == table.end());
+					REQUIRE_THROWS(table.erase("i am minh"));
+				}
+				SECTION("yields begin() is 'i am afsa','a persian'")
+				{
+					REQUIRE(*table.begin() == data_structures_cpp::key_value_pair<const std::string, std::string>("i am afsa", "a persian"));
+					REQUIRE(++table.begin() == table.end());
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("robin_hood_hash_table grows and reuses erased slots", "[robin_hood_hash_table]")
+{
+	data_structures_cpp::robin_hood_hash_table<int, int, std::hash<int>> table{};
+	std::unordered_map<int, int> reference{};
+	for (int round = 0; round < 4; ++round)
+	{
+		for (int k = 0; k < 5000; ++k)
+		{
+			table.put(k * 7 + round, k);
+			reference[k * 7 + round] = k;
+		}
+		for (int k = 0; k < 5000; k += 2)
+		{
+			table.erase(k * 7 + round);
+			reference.erase(k * 7 + round);
+		}
+	}
+	REQUIRE(table.size() == reference.size());
+	REQUIRE(table.capacity() >= table.size());
+	for (auto const& kv : reference)
+	{
+		auto it = table.find(kv.first);
+		REQUIRE(it != table.end());
+		REQUIRE(it->value() == kv.second);
+	}
+	std::size_t iterated = 0;
+	for (auto it = table.begin(); it != table.end(); ++it, ++iterated)
+	{
+		REQUIRE(reference.count(it->key()) == 1);
+	}
+	REQUIRE(iterated == reference.size());
+	REQUIRE(table.find(-1) == table.end());
+
+	SECTION("reserve avoids rehashing while filling")
+	{
+		data_structures_cpp::robin_hood_hash_table<int, int, std::hash<int>> reserved{};
+		reserved.reserve(1000);
+		std::size_t capacity = reserved.capacity();
+		for (int k = 0; k < 1000; ++k) reserved.put(k, k);
+		REQUIRE(reserved.capacity() == capacity);
+	}
+}
+
+TEST_CASE("robin_hood_hash_table erases without tombstones", "[robin_hood_hash_table]")
+{
+	data_structures_cpp::robin_hood_hash_table<int, int, std::hash<int>> table{ 1000 };
+	std::size_t capacity = table.capacity();
+	SECTION("filling and emptying the table many times never grows it")
+	{
+		for (int round = 0; round < 100; ++round)
+		{
+			for (int k = 0; k < 1000; ++k) table.put(round * 1000 + k, k);
+			for (int k = 0; k < 1000; ++k) table.erase(round * 1000 + k);
+		}
+		REQUIRE(table.empty());
+		REQUIRE(table.begin() == table.end());
+		REQUIRE(table.capacity() == capacity);
+	}
+	SECTION("erasing from the middle of probe sequences keeps the others reachable")
+	{
+		for (int k = 0; k < 1000; ++k) table.put(k, k);
+		for (int k = 0; k < 1000; k += 3) table.erase(k);
+		bool coherent = true;
+		for (int k = 0; k < 1000; ++k)
+		{
+			auto it = table.find(k);
+			coherent = coherent && (k % 3 == 0 ? it == table.end() : it != table.end() && it->value() == k);
+		}
+		REQUIRE(coherent);
+		REQUIRE(table.size() == 666);
+	}
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include <string>
+#include <vector>
 #include <functional>
 
 #include "map/separate_chaining_hash_table.h"
@@ -28,6 +29,13 @@ TEST_CASE("separate_chaining_hash_table read/write is coherent", "[separate_chai
 				REQUIRE((*table.find("i am afsa", "a persian")).key() == "i am afsa");
 				REQUIRE((*table.find("i am afsa", "a persian")).value() == "a persian");
 			}
+			SECTION("find_or_put keeps existing entries and puts missing ones")
+			{
+				REQUIRE((*table.find_or_put("i am minh", "a canadian")).value() == "a vietnamese");
+				REQUIRE((*table.find_or_put("i am ahzeen", "an iranian")).value() == "an iranian");
+				REQUIRE((*table.find_or_put("i am tom")).value() == "");
+				REQUIRE(table.size() == 4);
+			}
 			SECTION("erasing 'i am minh','a vietnamese'")
 			{
 				table.erase(table.find("i am minh", "a vietnamese"));
@@ -43,4 +51,272 @@ TEST_CASE("separate_chaining_hash_table read/write is coherent", "[separate_chai
 			}
 		}
 	}
+}
+
+TEST_CASE("separate_chaining_hash_table grows with its load factor", "[separate_chaining_hash_table]")
+{
+	SECTION("given a separate_chaining_hash_table with a single bucket")
+	{
+		data_structures_cpp::separate_chaining_hash_table<int, int, std::hash<int>> table{ 1 };
+		REQUIRE(table.bucket_count() == 1);
+		REQUIRE(table.max_load_factor() == 1.0f);
+		table.put(0, 0);
+		auto const* first = &*table.find(0, 0);
+		SECTION("putting 10000 elements keeps load_factor() under max_load_factor()")
+		{
+			for (int i = 1; i < 10000; ++i) table.put(i, 2 * i);
+			REQUIRE(table.size() == 10000);
+			REQUIRE(table.bucket_count() >= 10000);
+			REQUIRE(table.load_factor() <= table.max_load_factor());
+			SECTION("and every element can still be found")
+			{
+				bool all_found = true;
+				for (int i = 0; i < 10000; ++i) all_found = all_found && (*table.find(i, 0)).value() == 2 * i;
+				REQUIRE(all_found);
+				int n = 0;
+				for (auto it = table.begin(); it != table.end(); ++it) ++n;
+				REQUIRE(n == 10000);
+			}
+			SECTION("and existing entries are relinked rather than reallocated")
+			{
+				REQUIRE(&*table.find(0, 0) == first);
+			}
+		}
+		SECTION("reserve(1000) makes room for 1000 elements without rehashing")
+		{
+			table.reserve(1000);
+			std::size_t buckets = table.bucket_count();
+			REQUIRE(buckets >= 1000);
+			for (int i = 1; i < 1000; ++i) table.put(i, i);
+			REQUIRE(table.bucket_count() == buckets);
+		}
+		SECTION("lowering max_load_factor() rehashes right away")
+		{
+			for (int i = 1; i < 100; ++i) table.put(i, i);
+			table.max_load_factor(0.25f);
+			REQUIRE(table.load_factor() <= 0.25f);
+			REQUIRE_THROWS(table.max_load_factor(0.0f));
+		}
+		SECTION("rehash(n) rounds the bucket count up to a power of two")
+		{
+			table.rehash(1000);
+			REQUIRE(table.bucket_count() == 1024);
+			REQUIRE((*table.find(0, 0)).value() == 0);
+		}
+	}
+}
+
+TEST_CASE("separate_chaining_hash_table rehashes incrementally", "[separate_chaining_hash_table]")
+{
+	using table_t = data_structures_cpp::separate_chaining_hash_table<int, int, std::hash<int>,
+		data_structures_cpp::rehash_tags::incremental>;
+	SECTION("given an incrementally rehashed table grown to 1024 buckets")
+	{
+		table_t table{ 1 };
+		for (int i = 0; i < 1024; ++i) table.put(i, i);
+		REQUIRE(table.bucket_count() == 1024);
+		SECTION("the next insertion starts a migration instead of relinking everything")
+		{
+			table.put(1024, 1024);
+			REQUIRE(table.rehashing());
+			REQUIRE(table.bucket_count() == 2048);
+			REQUIRE(table.size() == 1025);
+			SECTION("entries are found and iterated wherever they currently live")
+			{
+				bool all_found = true;
+				for (int i = 0; i <= 1024 && table.rehashing(); ++i)
+				{
+					auto it = table.find(i, 0);
+					all_found = all_found && it != table.end() && (*it).value() == i;
+				}
+				REQUIRE(all_found);
+				table.put(5000, 5000);
+				int n = 0;
+				for (auto it = table.begin(); it != table.end(); ++it) ++n;
+				REQUIRE(n == 1026);
+			}
+			SECTION("erasing and overwriting during the migration")
+			{
+				table.erase(0);
+				table.put(1, -1);
+				REQUIRE(table.find(0, 0) == table.end());
+				REQUIRE((*table.find(1, 0)).value() == -1);
+				REQUIRE(table.size() == 1024);
+			}
+			SECTION("bounded work per operation eventually drains the old buckets")
+			{
+				int steps = 0;
+				while (table.rehashing()) table.find(steps++, 0);
+				REQUIRE(steps <= 1024 / 8);
+				bool all_found = true;
+				for (int i = 0; i <= 1024; ++i) all_found = all_found && (*table.find(i, 0)).value() == i;
+				REQUIRE(all_found);
+			}
+			SECTION("growing again finishes the current migration first")
+			{
+				for (int i = 1025; i < 100000; ++i) table.put(i, i);
+				REQUIRE(table.size() == 100000);
+				REQUIRE(table.load_factor() <= table.max_load_factor());
+				bool all_found = true;
+				for (int i = 0; i < 100000; ++i) all_found = all_found && (*table.find(i, 0)).value() == i;
+				REQUIRE(all_found);
+			}
+			SECTION("rehash(n) relinks what is left of the migration at once")
+			{
+				table.rehash(8192);
+				REQUIRE_FALSE(table.rehashing());
+				REQUIRE(table.bucket_count() == 8192);
+				int n = 0;
+				for (auto it = table.begin(); it != table.end(); ++it) ++n;
+				REQUIRE(n == 1025);
+			}
+		}
+	}
+}
+
+TEST_CASE("separate_chaining_hash_table batched operations match single ones", "[separate_chaining_hash_table]")
+{
+	using table_t = data_structures_cpp::separate_chaining_hash_table<int, int, std::hash<int>>;
+	table_t table{};
+	SECTION("put_batch inserts new keys and overwrites existing ones, growing as needed")
+	{
+		table.put(3, -1);
+		std::vector<table_t::entry_t> entries{};
+		for (int i = 0; i < 5000; ++i) entries.emplace_back(i, 2 * i);
+		table.put_batch(entries);
+		REQUIRE(table.size() == 5000);
+		REQUIRE((*table.find(3)).value() == 6);
+		SECTION("find_batch resolves present and absent keys in order")
+		{
+			std::vector<int> keys{};
+			for (int i = 0; i < 10000; i += 3) keys.push_back(i % 2 ? i : -i - 1);
+			std::vector<table_t::iterator> out{ table.end() };
+			table.find_batch(keys, out);
+			REQUIRE(out.size() == keys.size());
+			bool coherent = true;
+			for (std::size_t i = 0; i < keys.size(); ++i)
+			{
+				bool present = keys[i] >= 0 && keys[i] < 5000;
+				coherent = coherent && (present ? out[i] != table.end() && (*out[i]).value() == 2 * keys[i] : out[i] == table.end());
+			}
+			REQUIRE(coherent);
+		}
+		SECTION("find_batch of an empty batch yields nothing")
+		{
+			std::vector<table_t::iterator> out{};
+			table.find_batch({}, out);
+			REQUIRE(out.empty());
+		}
+	}
+	SECTION("find_batch iterators stay valid across a batch taken during an incremental migration")
+	{
+		data_structures_cpp::separate_chaining_hash_table<int, int, std::hash<int>,
+			data_structures_cpp::rehash_tags::incremental> incremental{ 1 };
+		for (int i = 0; i <= 1024; ++i) incremental.put(i, 3 * i);
+		REQUIRE(incremental.rehashing());
+		std::vector<int> keys{};
+		for (int i = 0; i <= 1024; ++i) keys.push_back(i);
+		std::vector<decltype(incremental)::iterator> out{};
+		incremental.find_batch(keys, out);
+		REQUIRE(incremental.rehashing());
+		bool coherent = out.size() == keys.size();
+		for (std::size_t i = 0; coherent && i < keys.size(); ++i)
+		{
+			coherent = out[i] != incremental.end() && (*out[i]).key() == keys[i] && (*out[i]).value() == 3 * keys[i];
+		}
+		REQUIRE(coherent);
+	}
+}
+
+namespace {
+
+// keeps only 4 bits of the key, most entries collide
+struct poor_hash
+{
+	std::size_t operator()(int k) const { return k & 0xf; }
+};
+
+}
+
+TEST_CASE("separate_chaining_hash_table statistics reveal poor hashers", "[separate_chaining_hash_table]")
+{
+	data_structures_cpp::separate_chaining_hash_table<int, int> good{};
+	data_structures_cpp::separate_chaining_hash_table<int, int, poor_hash> poor{};
+	for (int k = 0; k < 4096; ++k)
+	{
+		good.put(k, k);
+		poor.put(k, k);
+	}
+	auto good_stats = good.statistics();
+	auto poor_stats = poor.statistics();
+	REQUIRE(good_stats.size == 4096);
+	REQUIRE(good_stats.bucket_count == good.bucket_count());
+	std::size_t buckets = 0, entries = 0;
+	for (std::size_t n = 0; n < good_stats.bucket_size_histogram.size(); ++n)
+	{
+		buckets += good_stats.bucket_size_histogram[n];
+		entries += n * good_stats.bucket_size_histogram[n];
+	}
+	REQUIRE(buckets == good.bucket_count());
+	REQUIRE(entries == 4096);
+	REQUIRE(good_stats.max_probe_length < 12);
+	REQUIRE(good_stats.collision_rate < 0.5);
+	REQUIRE(poor_stats.max_probe_length == 256);
+	REQUIRE(poor_stats.collision_rate > 0.99);
+	REQUIRE(poor_stats.mean_probe_length > 100);
+}
+
+TEST_CASE("separate_chaining_hash_table with a filter behaves like without", "[separate_chaining_hash_table]")
+{
+	using table_t = data_structures_cpp::separate_chaining_hash_table<int, int>;
+	using incremental_table_t = data_structures_cpp::separate_chaining_hash_table<int, int,
+		data_structures_cpp::default_hash<int>, data_structures_cpp::rehash_tags::incremental>;
+	SECTION("given a filtered table of the even keys below 20000")
+	{
+		table_t table{ 1 };
+		table.enable_filter(0.01);
+		REQUIRE(table.filtered());
+		for (int i = 0; i < 20000; i += 2) table.put(i, i);
+		SECTION("every key is found and odd keys are not")
+		{
+			bool all_right = true;
+			for (int i = 0; i < 20000; ++i) all_right = all_right && (table.find(i) != table.end()) == (i % 2 == 0);
+			REQUIRE(all_right);
+		}
+		SECTION("erased keys are not found, put again they are")
+		{
+			table.erase(10);
+			REQUIRE(table.find(10) == table.end());
+			table.put(10, -10);
+			REQUIRE((*table.find(10)).value() == -10);
+			REQUIRE(table.size() == 10000);
+		}
+		SECTION("disabling the filter keeps every entry")
+		{
+			table.disable_filter();
+			REQUIRE_FALSE(table.filtered());
+			REQUIRE((*table.find(19998)).value() == 19998);
+			REQUIRE(table.find(19999) == table.end());
+		}
+	}
+	SECTION("a filter enabled on a full table covers its entries")
+	{
+		table_t table{};
+		for (int i = 0; i < 5000; ++i) table.put(i, i);
+		table.enable_filter(0.001);
+		bool all_found = true;
+		for (int i = 0; i < 5000; ++i) all_found = all_found && (*table.find(i)).value() == i;
+		REQUIRE(all_found);
+		REQUIRE(table.find(5000) == table.end());
+	}
+	SECTION("the filter follows an incremental migration")
+	{
+		incremental_table_t table{ 1 };
+		table.enable_filter();
+		for (int i = 0; i < 1025; ++i) table.put(i, i);
+		REQUIRE(table.rehashing());
+		bool all_right = true;
+		for (int i = 0; i < 2000; ++i) all_right = all_right && (table.find(i) != table.end()) == (i < 1025);
+		REQUIRE(all_right);
+	}
 }
\ No newline at end of file
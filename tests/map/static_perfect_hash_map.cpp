@@ -0,0 +1,97 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "map/static_perfect_hash_map.h"
+
+namespace {
+
+// every key shares the same hash, no level can tell them apart
+struct constant_hash
+{
+	std::size_t operator()(int) const { return 42; }
+};
+
+}
+
+TEST_CASE("static_perfect_hash_map finds every key of its set", "[static_perfect_hash_map]")
+{
+	using entry_t = data_structures_cpp::key_value_pair<std::string, int>;
+	SECTION("given an empty static_perfect_hash_map")
+	{
+		data_structures_cpp::static_perfect_hash_map<std::string, int> map{};
+		REQUIRE(map.empty());
+		REQUIRE(map.begin() == map.end());
+		REQUIRE(map.find("i am minh") == map.end());
+	}
+	SECTION("given a static_perfect_hash_map of 'i am minh','a vietnamese' and 'i am afsa','a persian'")
+	{
+		std::vector<data_structures_cpp::key_value_pair<std::string, std::string>> entries{
+			{ "i am minh", "a vietnamese" }, { "i am afsa", "a persian" } };
+		data_structures_cpp::static_perfect_hash_map<std::string, std::string> map(entries);
+		REQUIRE(map.size() == 2);
+		REQUIRE(map.find("i am minh")->value() == "a vietnamese");
+		REQUIRE(map.find(std::string_view("i am afsa"))->value() == "a persian");
+		REQUIRE(map.find("i am nobody") == map.end());
+	}
+	SECTION("given 100000 keys built on 4 threads")
+	{
+		std::vector<entry_t> entries{};
+		for (int i = 0; i < 100000; ++i) entries.emplace_back("key " + std::to_string(i), i);
+		data_structures_cpp::static_perfect_hash_map<std::string, int> map(entries, 4);
+		REQUIRE(map.size() == 100000);
+		SECTION("every key is found with its value")
+		{
+			for (int i = 0; i < 100000; ++i)
+			{
+				auto it = map.find("key " + std::to_string(i));
+				REQUIRE(it != map.end());
+				REQUIRE(it->value() == i);
+			}
+		}
+		SECTION("keys outside the set are not found")
+		{
+			for (int i = 100000; i < 200000; ++i) REQUIRE(map.find("key " + std::to_string(i)) == map.end());
+		}
+		SECTION("every entry is stored once")
+		{
+			std::vector<bool> seen(100000, false);
+			for (auto it = map.begin(); it != map.end(); ++it)
+			{
+				REQUIRE_FALSE(seen[it->value()]);
+				seen[it->value()] = true;
+			}
+		}
+		SECTION("the perfect hash takes about 3 bits per key")
+		{
+			REQUIRE(map.bits_per_key() < 4);
+			REQUIRE(map.level_count() < 32);
+		}
+		SECTION("building on one thread gives the same map")
+		{
+			data_structures_cpp::static_perfect_hash_map<std::string, int> serial(entries, 1);
+			for (int i = 0; i < 100000; i += 97)
+			{
+				std::string k = "key " + std::to_string(i);
+				REQUIRE(serial.find(k) - serial.begin() == map.find(k) - map.begin());
+			}
+		}
+	}
+	SECTION("keys sharing their whole hash are still found")
+	{
+		std::vector<data_structures_cpp::key_value_pair<int, int>> entries{};
+		for (int i = 0; i < 100; ++i) entries.emplace_back(i, -i);
+		data_structures_cpp::static_perfect_hash_map<int, int, constant_hash> map(entries);
+		for (int i = 0; i < 100; ++i) REQUIRE(map.find(i)->value() == -i);
+		REQUIRE(map.find(100) == map.end());
+	}
+	SECTION("duplicate keys are refused")
+	{
+		std::vector<entry_t> entries{ { "a", 1 }, { "b", 2 }, { "a", 3 } };
+		REQUIRE_THROWS_AS((data_structures_cpp::static_perfect_hash_map<std::string, int>(entries)), std::runtime_error);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,11 @@
 #include <catch2/catch.hpp>
 
+#include <set>
+#include <random>
+#include <string>
+#include <vector>
+#include <stdexcept>
+
 #include "priority_queue/adaptable_priority_queue.h"
 
 TEST_CASE("adaptable_priority_queue remains sorted", "[adaptable_priority_queue]")
@@ -114,4 +120,114 @@ TEST_CASE("adaptable_priority_queue remains sorted", "[adaptable_priority_queue]
 			}
 		}
 	}
+}
+
+TEST_CASE("adaptable_priority_queue moves its elements", "[adaptable_priority_queue]")
+{
+	data_structures_cpp::adaptable_priority_queue<std::string> queue{};
+	std::string b(100, 'b');
+	auto pb = queue.insert(std::move(b));
+	REQUIRE(b.empty());
+	auto pa = queue.emplace(100, 'a');
+	queue.emplace("c");
+	REQUIRE(*pa == std::string(100, 'a'));
+	pb = queue.replace(pb, std::string("d"));
+	REQUIRE(*pb == "d");
+	REQUIRE(queue.pop_value() == std::string(100, 'a'));
+	REQUIRE(queue.pop_value() == "c");
+	REQUIRE(queue.pop_value() == "d");
+	REQUIRE(queue.empty());
+}
+
+namespace {
+
+// inserts, pops, removes, replaces and decreases random elements, checking every front against a multiset
+template <std::size_t Arity>
+bool matches_multiset(unsigned seed)
+{
+	data_structures_cpp::adaptable_priority_queue<int, std::less<int>, Arity> queue{};
+	std::multiset<int> expected{};
+	std::vector<data_structures_cpp::position<int>> positions{};
+	std::mt19937 generator{ seed };
+	bool all_equal = true;
+	for (int step = 0; step < 20000; ++step)
+	{
+		// the step breaks ties so every value is unique and designates a single position
+		int value = static_cast<int>(generator() % 10000) * 20000 + step;
+		std::size_t operation = expected.empty() ? 0 : generator() % 5;
+		std::size_t i = positions.empty() ? 0 : generator() % positions.size();
+		if (operation == 0 || operation == 4)
+		{
+			positions.push_back(queue.insert(value));
+			expected.insert(value);
+		}
+		else if (operation == 1)
+		{
+			// the position of the front element is looked up before popping it, then dropped
+			std::size_t j = 0;
+			while (*positions[j] != queue.front()) ++j;
+			queue.pop();
+			positions.erase(positions.begin() + j);
+			expected.erase(expected.begin());
+		}
+		else if (operation == 2)
+		{
+			expected.erase(expected.find(*positions[i]));
+			queue.remove(positions[i]);
+			positions.erase(positions.begin() + i);
+		}
+		else
+		{
+			expected.erase(expected.find(*positions[i]));
+			if (value <= *positions[i]) queue.decrease_key(positions[i], value);
+			else positions[i] = queue.replace(positions[i], value);
+			expected.insert(value);
+		}
+		all_equal = all_equal && queue.size() == expected.size() && (expected.empty() || queue.front() == *expected.begin());
+	}
+	return all_equal;
+}
+
+}
+
+TEST_CASE("adaptable_priority_queue updates elements through their positions", "[adaptable_priority_queue]")
+{
+	SECTION("random operations on a binary heap") { REQUIRE(matches_multiset<2>(1)); }
+	SECTION("random operations on a 4-ary heap") { REQUIRE(matches_multiset<4>(2)); }
+	SECTION("given a queue of 1, 5, 9")
+	{
+		data_structures_cpp::adaptable_priority_queue<int> queue{};
+		auto p1 = queue.insert(1);
+		auto p5 = queue.insert(5);
+		auto p9 = queue.insert(9);
+		SECTION("decreasing 9 to 0 brings it to the front")
+		{
+			queue.decrease_key(p9, 0);
+			REQUIRE(queue.front() == 0);
+			REQUIRE(*p9 == 0);
+			REQUIRE(*p1 == 1);
+		}
+		SECTION("decreasing a key to a larger value is refused")
+		{
+			REQUIRE_THROWS_AS(queue.decrease_key(p1, 7), std::runtime_error);
+			REQUIRE(*p1 == 1);
+		}
+		SECTION("replacing the front with a larger value sends it down")
+		{
+			REQUIRE(queue.replace(p1, 7) == p1);
+			REQUIRE(queue.front() == 5);
+			REQUIRE(queue.pop_value() == 5);
+			REQUIRE(queue.pop_value() == 7);
+			REQUIRE(*p9 == 9);
+		}
+		SECTION("positions of the remaining elements survive pops")
+		{
+			queue.pop();
+			REQUIRE(*p5 == 5);
+			REQUIRE(*p9 == 9);
+			auto p3 = queue.insert(3);
+			REQUIRE(*p3 == 3);
+			REQUIRE(queue.front() == 3);
+		}
+	}
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <catch2/catch.hpp>
 
+#include <memory>
+#include <vector>
+
 #include "priority_queue/list_priority_queue.h"
 
 TEST_CASE("list_priority_queue remains sorted", "[list_priority_queue]")
@@ -98,4 +101,18 @@ TEST_CASE("list_priority_queue remains sorted", "[list_priority_queue]")
 			}
 		}
 	}
+}
+
+TEST_CASE("list_priority_queue moves its elements", "[list_priority_queue]")
+{
+	struct pointee_less
+	{
+		bool operator()(std::unique_ptr<int> const& a, std::unique_ptr<int> const& b) const { return *a < *b; }
+	};
+	data_structures_cpp::list_priority_queue<std::unique_ptr<int>, pointee_less> queue{};
+	for (int i : { 5, 3, 8, 1 }) queue.push(std::make_unique<int>(i));
+	queue.emplace(new int(4));
+	std::vector<int> values{};
+	while (!queue.empty()) values.push_back(*queue.pop_value());
+	REQUIRE(values == std::vector<int>{ 1, 3, 4, 5, 8 });
 }
\ No newline at end of file
@@ -0,0 +1,245 @@
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+#include <functional>
+
+#include "priority_queue/pairing_heap.h"
+
+TEST_CASE("pairing_heap pops in order", "[pairing_heap]")
+{
+	SECTION("given an empty pairing_heap")
+	{
+		data_structures_cpp::pairing_heap<int> heap{};
+		REQUIRE(heap.empty());
+		REQUIRE(heap.size() == 0);
+		SECTION("pushing elements 3, 5, 1, 23, 4, 4")
+		{
+			for (int x : { 3, 5, 1, 23, 4, 4 }) heap.push(x);
+			REQUIRE(heap.size() == 6);
+			REQUIRE(heap.front() == 1);
+			SECTION("popping yields 1, 3, 4, 4, 5, 23")
+			{
+				std::vector<int> popped{};
+				while (!heap.empty()) popped.push_back(heap.pop_value());
+				REQUIRE(popped == std::vector<int>{ 1, 3, 4, 4, 5, 23 });
+			}
+		}
+	}
+	SECTION("a max-heap with std::greater")
+	{
+		data_structures_cpp::pairing_heap<int, std::greater<int>> heap{};
+		for (int x : { 3, 5, 1, 23, 4 }) heap.push(x);
+		REQUIRE(heap.pop_value() == 23);
+		REQUIRE(heap.front() == 5);
+	}
+	SECTION("random pushes and pops match a sorted order")
+	{
+		std::mt19937 generator{ 7 };
+		data_structures_cpp::pairing_heap<int> heap{};
+		std::multiset<int> expected{};
+		for (int i = 0; i < 5000; ++i)
+		{
+			if (expected.empty() || generator() % 3 != 0)
+			{
+				int x = static_cast<int>(generator() % 1000);
+				heap.push(x);
+				expected.insert(x);
+			}
+			else
+			{
+				REQUIRE(heap.front() == *expected.begin());
+				heap.pop();
+				expected.erase(expected.begin());
+			}
+			REQUIRE(heap.size() == expected.size());
+		}
+	}
+}
+
+TEST_CASE("pairing_heap positions", "[pairing_heap]")
+{
+	data_structures_cpp::pairing_heap<int> heap{};
+	auto p10 = heap.push(10);
+	auto p20 = heap.push(20);
+	auto p30 = heap.push(30);
+	heap.push(15);
+	SECTION("decrease_key moves an element to the front")
+	{
+		heap.decrease_key(p30, 5);
+		REQUIRE(*p30 == 5);
+		REQUIRE(heap.front() == 5);
+		REQUIRE(heap.pop_value() == 5);
+		REQUIRE(heap.pop_value() == 10);
+		REQUIRE(heap.pop_value() == 15);
+		REQUIRE(heap.pop_value() == 20);
+	}
+	SECTION("decrease_key of the front element")
+	{
+		heap.decrease_key(p10, 1);
+		REQUIRE(heap.front() == 1);
+		REQUIRE(heap.size() == 4);
+	}
+	SECTION("decrease_key to an equal value is allowed")
+	{
+		heap.decrease_key(p20, 20);
+		REQUIRE(*p20 == 20);
+	}
+	SECTION("decrease_key refuses a value ordered after the current one")
+	{
+		REQUIRE_THROWS_AS(heap.decrease_key(p20, 25), std::runtime_error);
+		REQUIRE(*p20 == 20);
+	}
+	SECTION("remove takes out any element")
+	{
+		heap.remove(p20);
+		REQUIRE(heap.size() == 3);
+		heap.remove(p10);
+		REQUIRE(heap.front() == 15);
+		REQUIRE(heap.pop_value() == 15);
+		REQUIRE(heap.pop_value() == 30);
+		REQUIRE(heap.empty());
+	}
+	SECTION("positions stay valid while other elements come and go")
+	{
+		heap.pop();
+		for (int x = 100; x < 200; ++x) heap.push(x);
+		heap.remove(p20);
+		REQUIRE(*p30 == 30);
+		heap.decrease_key(p30, 0);
+		REQUIRE(heap.front() == 0);
+	}
+}
+
+TEST_CASE("pairing_heap meld", "[pairing_heap]")
+{
+	data_structures_cpp::pairing_heap<int> a{}, b{};
+	for (int x : { 8, 2, 6 }) a.push(x);
+	auto p = b.push(9);
+	for (int x : { 1, 7 }) b.push(x);
+	SECTION("moves every element into the heap")
+	{
+		a.meld(b);
+		REQUIRE(b.empty());
+		REQUIRE(a.size() == 6);
+		std::vector<int> popped{};
+		while (!a.empty()) popped.push_back(a.pop_value());
+		REQUIRE(popped == std::vector<int>{ 1, 2, 6, 7, 8, 9 });
+	}
+	SECTION("positions of the melded heap designate its elements in the new one")
+	{
+		a.meld(b);
+		a.decrease_key(p, 0);
+		REQUIRE(a.front() == 0);
+		a.remove(p);
+		REQUIRE(a.front() == 1);
+	}
+	SECTION("the emptied heap is usable again")
+	{
+		a.meld(b);
+		b.push(3);
+		REQUIRE(b.front() == 3);
+		b.meld(a);
+		REQUIRE(b.size() == 7);
+		REQUIRE(b.front() == 1);
+	}
+	SECTION("unused storage of the melded heap is filled before allocating again")
+	{
+		data_structures_cpp::pairing_heap<int> c{}, d{};
+		c.push(1);
+		d.push(2);
+		c.meld(d);
+		std::size_t capacity = c.capacity();
+		REQUIRE(capacity >= 2);
+		for (int x = 3; c.size() < capacity; ++x) c.push(x);
+		REQUIRE(c.capacity() == capacity);
+		for (int x = 1; !c.empty(); ++x) REQUIRE(c.pop_value() == x);
+	}
+	SECTION("melding with an empty heap or itself changes nothing")
+	{
+		data_structures_cpp::pairing_heap<int> empty{};
+		a.meld(empty);
+		a.meld(a);
+		REQUIRE(a.size() == 3);
+		empty.meld(a);
+		REQUIRE(empty.size() == 3);
+		REQUIRE(empty.front() == 2);
+	}
+	SECTION("random shards melded together match a sorted order")
+	{
+		std::mt19937 generator{ 11 };
+		std::multiset<int> expected{};
+		std::vector<data_structures_cpp::pairing_heap<int>> shards(8);
+		for (auto& shard : shards)
+		{
+			for (int i = 0; i < 300; ++i)
+			{
+				int x = static_cast<int>(generator() % 10000);
+				shard.push(x);
+				expected.insert(x);
+			}
+			for (int i = 0; i < 50; ++i)
+			{
+				expected.erase(expected.find(shard.front()));
+				shard.pop();
+			}
+		}
+		data_structures_cpp::pairing_heap<int> all{};
+		for (auto& shard : shards) all.meld(shard);
+		REQUIRE(all.size() == expected.size());
+		for (int x : expected) REQUIRE(all.pop_value() == x);
+	}
+}
+
+TEST_CASE("pairing_heap owns its elements", "[pairing_heap]")
+{
+	SECTION("strings are destroyed with the heap")
+	{
+		data_structures_cpp::pairing_heap<std::string> heap{};
+		for (int i = 0; i < 100; ++i) heap.push(std::string(40, static_cast<char>('a' + i % 26)));
+		for (int i = 0; i < 30; ++i) heap.pop();
+		REQUIRE(heap.size() == 70);
+	}
+	SECTION("destroying the heap destroys every element left exactly once")
+	{
+		// shared_ptr copies report how many elements still hold them
+		auto tracker = std::make_shared<int>(0);
+		{
+			data_structures_cpp::pairing_heap<std::pair<int, std::shared_ptr<int>>> heap{};
+			for (int i = 0; i < 1000; ++i) heap.push({ (i * 7919) % 1000, tracker });
+			for (int i = 0; i < 10; ++i) heap.pop();
+			REQUIRE(tracker.use_count() == 991);
+		}
+		REQUIRE(tracker.use_count() == 1);
+	}
+	SECTION("move-only elements go in with emplace and out with pop_value")
+	{
+		struct by_value
+		{
+			bool operator()(std::unique_ptr<int> const& a, std::unique_ptr<int> const& b) const { return *a < *b; }
+		};
+		data_structures_cpp::pairing_heap<std::unique_ptr<int>, by_value> heap{};
+		heap.emplace(new int(3));
+		heap.push(std::make_unique<int>(1));
+		auto p = heap.emplace(new int(2));
+		heap.decrease_key(p, std::make_unique<int>(0));
+		REQUIRE(*heap.pop_value() == 0);
+		REQUIRE(*heap.pop_value() == 1);
+		REQUIRE(*heap.pop_value() == 3);
+	}
+	SECTION("a moved heap keeps its elements and positions")
+	{
+		data_structures_cpp::pairing_heap<int> heap{};
+		auto p = heap.push(4);
+		heap.push(2);
+		data_structures_cpp::pairing_heap<int> moved{ std::move(heap) };
+		REQUIRE(moved.size() == 2);
+		moved.decrease_key(p, 1);
+		REQUIRE(moved.front() == 1);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include <catch2/catch.hpp>
 
+#include <queue>
+#include <memory>
+#include <string>
+#include <iterator>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <functional>
+
 #include "priority_queue/vector_priority_queue.h"
 
 TEST_CASE("vector_priority_queue remains sorted", "[vector_priority_queue]")
@@ -98,4 +107,170 @@ TEST_CASE("vector_priority_queue remains sorted", "[vector_priority_queue]")
 			}
 		}
 	}
+}
+
+namespace {
+
+// pushes and pops random values, checking every front against std::priority_queue
+template <std::size_t Arity, typename TComparator = std::less<int>>
+bool matches_std_priority_queue(unsigned seed)
+{
+	data_structures_cpp::vector_priority_queue<int, TComparator, Arity> queue{};
+	std::priority_queue<int, std::vector<int>, std::function<bool(int, int)>> expected(
+		[](int a, int b) { return TComparator{}(b, a); });
+	std::mt19937 generator{ seed };
+	bool all_equal = true;
+	for (int i = 0; i < 20000; ++i)
+	{
+		if (expected.empty() || generator() % 3 != 0)
+		{
+			int value = static_cast<int>(generator() % 1000);
+			queue.push(value);
+			expected.push(value);
+		}
+		else
+		{
+			queue.pop();
+			expected.pop();
+		}
+		all_equal = all_equal && queue.size() == expected.size() && (expected.empty() || queue.front() == expected.top());
+	}
+	while (!expected.empty())
+	{
+		all_equal = all_equal && queue.front() == expected.top();
+		queue.pop();
+		expected.pop();
+	}
+	return all_equal && queue.empty();
+}
+
+}
+
+TEST_CASE("vector_priority_queue orders elements whatever its arity", "[vector_priority_queue]")
+{
+	SECTION("binary heap") { REQUIRE(matches_std_priority_queue<2>(1)); }
+	SECTION("3-ary heap") { REQUIRE(matches_std_priority_queue<3>(2)); }
+	SECTION("4-ary heap") { REQUIRE(matches_std_priority_queue<4>(3)); }
+	SECTION("8-ary heap") { REQUIRE(matches_std_priority_queue<8>(4)); }
+	SECTION("8-ary max heap") { REQUIRE(matches_std_priority_queue<8, std::greater<int>>(5)); }
+	SECTION("popping down to one element and pushing again")
+	{
+		data_structures_cpp::vector_priority_queue<int, std::less<int>, 4> queue{};
+		queue.push(2);
+		queue.push(1);
+		queue.pop();
+		REQUIRE(queue.front() == 2);
+		queue.pop();
+		REQUIRE(queue.empty());
+		queue.push(7);
+		REQUIRE(queue.front() == 7);
+	}
+}
+
+namespace {
+
+std::size_t comparisons = 0;
+
+struct counting_less
+{
+	bool operator()(int a, int b) const
+	{
+		++comparisons;
+		return a < b;
+	}
+};
+
+template <std::size_t Arity>
+std::vector<int> drain(data_structures_cpp::vector_priority_queue<int, std::less<int>, Arity>& queue)
+{
+	std::vector<int> values{};
+	for (; !queue.empty(); queue.pop()) values.push_back(queue.front());
+	return values;
+}
+
+}
+
+TEST_CASE("vector_priority_queue builds from ranges in linear time", "[vector_priority_queue]")
+{
+	std::mt19937 generator{ 7 };
+	std::vector<int> values(100000);
+	for (int& v : values) v = static_cast<int>(generator() % 50000);
+	std::vector<int> sorted = values;
+	std::sort(sorted.begin(), sorted.end());
+	SECTION("constructing from a range yields every element in order")
+	{
+		data_structures_cpp::vector_priority_queue<int, std::less<int>, 4> queue(values.begin(), values.end());
+		REQUIRE(queue.size() == values.size());
+		REQUIRE(drain(queue) == sorted);
+	}
+	SECTION("heapifying takes a linear number of comparisons")
+	{
+		comparisons = 0;
+		data_structures_cpp::vector_priority_queue<int, counting_less, 2> binary(values.begin(), values.end());
+		REQUIRE(comparisons < 2 * values.size());
+		comparisons = 0;
+		data_structures_cpp::vector_priority_queue<int, counting_less, 8> wide(values.begin(), values.end());
+		REQUIRE(comparisons < 2 * values.size());
+	}
+	SECTION("pushing short and long ranges")
+	{
+		data_structures_cpp::vector_priority_queue<int> queue(values.begin(), values.begin() + 50000);
+		queue.push_range(values.begin() + 50000, values.begin() + 50100);
+		queue.push_range(values.begin() + 50100, values.end());
+		REQUIRE(drain(queue) == sorted);
+	}
+	SECTION("pushing a range into an empty queue")
+	{
+		data_structures_cpp::vector_priority_queue<int, std::less<int>, 3> queue{};
+		queue.push_range(values.begin(), values.end());
+		REQUIRE(drain(queue) == sorted);
+	}
+	SECTION("pop_n extracts the front elements in order, few or many")
+	{
+		data_structures_cpp::vector_priority_queue<int, std::less<int>, 4> queue(values.begin(), values.end());
+		std::vector<int> out{};
+		queue.pop_n(10, std::back_inserter(out));
+		REQUIRE(out == std::vector<int>(sorted.begin(), sorted.begin() + 10));
+		queue.pop_n(60000, std::back_inserter(out));
+		REQUIRE(out == std::vector<int>(sorted.begin(), sorted.begin() + 60010));
+		REQUIRE(queue.size() == 100000 - 60010);
+		REQUIRE(queue.front() == sorted[60010]);
+		queue.pop_n(1000000, std::back_inserter(out));
+		REQUIRE(queue.empty());
+		REQUIRE(out == sorted);
+	}
+}
+
+namespace {
+
+struct pointee_less
+{
+	bool operator()(std::unique_ptr<int> const& a, std::unique_ptr<int> const& b) const { return *a < *b; }
+};
+
+}
+
+TEST_CASE("vector_priority_queue moves its elements", "[vector_priority_queue]")
+{
+	SECTION("given a queue of move-only elements")
+	{
+		data_structures_cpp::vector_priority_queue<std::unique_ptr<int>, pointee_less, 4> queue{};
+		for (int i : { 5, 3, 8, 1, 9, 2 }) queue.push(std::make_unique<int>(i));
+		queue.emplace(new int(0));
+		REQUIRE(queue.size() == 7);
+		SECTION("pop_value moves the elements out in order")
+		{
+			std::vector<int> values{};
+			while (!queue.empty()) values.push_back(*queue.pop_value());
+			REQUIRE(values == std::vector<int>{ 0, 1, 2, 3, 5, 8, 9 });
+		}
+	}
+	SECTION("pushing an rvalue leaves the source moved from")
+	{
+		data_structures_cpp::vector_priority_queue<std::string> queue{};
+		std::string s(100, 'x');
+		queue.push(std::move(s));
+		REQUIRE(s.empty());
+		REQUIRE(queue.pop_value() == std::string(100, 'x'));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "set/blocked_bloom_filter.h"
+
+TEST_CASE("blocked_bloom_filter never misses an inserted key", "[blocked_bloom_filter]")
+{
+	SECTION("given an empty filter")
+	{
+		data_structures_cpp::blocked_bloom_filter<std::string> filter(100);
+		REQUIRE_FALSE(filter.contains("i am minh"));
+		SECTION("inserting 'i am minh' and 'i am afsa'")
+		{
+			filter.insert("i am minh");
+			filter.insert(std::string("i am afsa"));
+			REQUIRE(filter.contains("i am minh"));
+			REQUIRE(filter.contains(std::string_view("i am afsa")));
+			REQUIRE(filter.contains(filter.hash_of("i am afsa")));
+			SECTION("clearing forgets every key")
+			{
+				filter.clear();
+				REQUIRE_FALSE(filter.contains("i am minh"));
+				REQUIRE_FALSE(filter.contains("i am afsa"));
+			}
+		}
+	}
+	SECTION("false positive rates outside (0, 1) are refused")
+	{
+		REQUIRE_THROWS_AS(data_structures_cpp::blocked_bloom_filter<int>(10, 0), std::runtime_error);
+		REQUIRE_THROWS_AS(data_structures_cpp::blocked_bloom_filter<int>(10, 1), std::runtime_error);
+	}
+}
+
+TEST_CASE("blocked_bloom_filter keeps the false positive rate asked for", "[blocked_bloom_filter]")
+{
+	std::uint64_t const n = 100000;
+	for (double rate : { 0.05, 0.01, 0.001 })
+	{
+		data_structures_cpp::blocked_bloom_filter<std::uint64_t> filter(n, rate);
+		for (std::uint64_t k = 0; k < n; ++k) filter.insert(k);
+		bool all_found = true;
+		for (std::uint64_t k = 0; k < n; ++k) all_found = all_found && filter.contains(k);
+		REQUIRE(all_found);
+		std::uint64_t false_positives = 0;
+		for (std::uint64_t k = n; k < 11 * n; ++k) false_positives += filter.contains(k);
+		double measured = static_cast<double>(false_positives) / (10 * n);
+		REQUIRE(measured < 1.5 * rate);
+		REQUIRE(measured > rate / 4);
+		REQUIRE(filter.false_positive_rate(n) <= rate);
+	}
+	SECTION("lower rates take more bits per key")
+	{
+		using filter_t = data_structures_cpp::blocked_bloom_filter<int>;
+		REQUIRE(filter_t::bits_per_key(0.01) < filter_t::bits_per_key(0.001));
+		REQUIRE(filter_t::bits_per_key(0.01) < 12);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <catch2/catch.hpp>
 
+#include <limits>
+#include <cstddef>
+
 #include "tree/avl_tree.h"
 
 TEST_CASE("avl_tree behaves coherently as map", "[avl_tree]")
@@ -70,4 +73,78 @@ TEST_CASE("avl_tree behaves coherently as map", "[avl_tree]")
 
 		}
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("avl_tree with order_statistic_entry answers select and rank", "[avl_tree]")
+{
+	SECTION("given an avl_tree filled with keys 0 to 99 in increasing order")
+	{
+		using entry_t = data_structures_cpp::order_statistic_entry<data_structures_cpp::avl_entry<int, int>>;
+		data_structures_cpp::avl_tree<int, int, entry_t> tree{};
+		for (int k = 0; k < 100; ++k) tree.insert(k, k * k);
+
+		SECTION("yields a balanced tree")
+		{
+			REQUIRE(tree.size() == 100);
+			REQUIRE(tree.find(50)->height() <= 8);
+		}
+		SECTION("select(i) yields key i and rank(i) yields i")
+		{
+			for (int k = 0; k < 100; ++k)
+			{
+				REQUIRE(tree.select(k)->key() == k);
+				REQUIRE(tree.select(k)->value() == k * k);
+				REQUIRE(tree.rank(k) == static_cast<std::size_t>(k));
+			}
+			REQUIRE(tree.select(100) == tree.end());
+		}
+		SECTION("erasing every even key")
+		{
+			for (int k = 0; k < 100; k += 2) tree.erase(k);
+			SECTION("keeps select and rank coherent through rebalancing")
+			{
+				REQUIRE(tree.size() == 50);
+				for (int i = 0; i < 50; ++i)
+				{
+					REQUIRE(tree.select(i)->key() == 2 * i + 1);
+					REQUIRE(tree.rank(2 * i + 1) == static_cast<std::size_t>(i));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("avl_tree with augmented_entry answers range aggregates", "[avl_tree]")
+{
+	SECTION("given avl_trees summing and minimizing values of keys 0 to 63")
+	{
+		using sum_entry_t = data_structures_cpp::augmented_entry<data_structures_cpp::avl_entry<int, int>, data_structures_cpp::value_sum<int>>;
+		using min_entry_t = data_structures_cpp::augmented_entry<data_structures_cpp::avl_entry<int, int>, data_structures_cpp::value_min<int>>;
+		data_structures_cpp::avl_tree<int, int, sum_entry_t> sums{};
+		data_structures_cpp::avl_tree<int, int, min_entry_t> mins{};
+		for (int k = 0; k < 64; ++k)
+		{
+			sums.insert(k, k);
+			mins.insert(63 - k, k);
+		}
+
+		SECTION("aggregate(lo, hi) combines the values of keys in [lo, hi)")
+		{
+			REQUIRE(sums.aggregate(0, 64) == 63 * 64 / 2);
+			REQUIRE(sums.aggregate(10, 20) == 145);
+			REQUIRE(sums.aggregate(20, 10) == 0);
+			REQUIRE(mins.aggregate(0, 64) == 0);
+			REQUIRE(mins.aggregate(0, 10) == 54);
+			REQUIRE(mins.aggregate(64, 100) == std::numeric_limits<int>::max());
+		}
+		SECTION("erasing keys 10 to 14")
+		{
+			for (int k = 10; k < 15; ++k) sums.erase(k);
+			SECTION("updates aggregates along the rebalanced paths")
+			{
+				REQUIRE(sums.aggregate(10, 20) == 85);
+				REQUIRE(sums.aggregate(0, 64) == 63 * 64 / 2 - 60);
+			}
+		}
+	}
+}
@@ -56,4 +56,47 @@ TEST_CASE("binary_search_tree behaves coherently as map", "[binary_search_tree]"
 
 		}
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("binary_search_tree with order_statistic_entry answers select and rank", "[binary_search_tree]")
+{
+	SECTION("given a binary_search_tree with keys 50, 30, 70, 20, 40, 60, 80")
+	{
+		using entry_t = data_structures_cpp::order_statistic_entry<data_structures_cpp::key_value_pair<int, int>>;
+		data_structures_cpp::binary_search_tree<int, int, entry_t> tree{};
+		for (int k : { 50, 30, 70, 20, 40, 60, 80 }) tree.insert(k, -k);
+
+		SECTION("select(i) yields the i-th smallest key")
+		{
+			int i = 0;
+			for (int k : { 20, 30, 40, 50, 60, 70, 80 })
+			{
+				REQUIRE(tree.select(i)->key() == k);
+				REQUIRE(tree.select(i)->value() == -k);
+				++i;
+			}
+			REQUIRE(tree.select(7) == tree.end());
+		}
+		SECTION("rank(k) yields the number of smaller keys")
+		{
+			REQUIRE(tree.rank(20) == 0);
+			REQUIRE(tree.rank(45) == 3);
+			REQUIRE(tree.rank(80) == 6);
+			REQUIRE(tree.rank(100) == 7);
+		}
+		SECTION("erasing 30 and 50")
+		{
+			tree.erase(30);
+			tree.erase(50);
+			SECTION("keeps select and rank coherent")
+			{
+				REQUIRE(tree.select(0)->key() == 20);
+				REQUIRE(tree.select(1)->key() == 40);
+				REQUIRE(tree.select(2)->key() == 60);
+				REQUIRE(tree.select(4)->key() == 80);
+				REQUIRE(tree.select(5) == tree.end());
+				REQUIRE(tree.rank(60) == 2);
+			}
+		}
+	}
+}
@@ -0,0 +1,52 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "tree/eytzinger_search_tree.h"
+
+TEST_CASE("eytzinger_search_tree finds every key and lower bounds in between", "[eytzinger_search_tree]")
+{
+	using tree_t = data_structures_cpp::eytzinger_search_tree<int, std::string>;
+	using entry_t = tree_t::entry_t;
+	SECTION("given an empty eytzinger_search_tree")
+	{
+		tree_t tree{};
+		REQUIRE(tree.empty());
+		REQUIRE(tree.find(1) == nullptr);
+		REQUIRE_FALSE(tree.lower_bound(1));
+	}
+	SECTION("given eytzinger_search_tree built from unsorted entries 30, 10, 20")
+	{
+		tree_t tree(std::vector<entry_t>{ entry_t(30, "c"), entry_t(10, "a"), entry_t(20, "b") });
+		REQUIRE(tree.size() == 3);
+		REQUIRE(*tree.find(10) == "a");
+		REQUIRE(*tree.find(20) == "b");
+		REQUIRE(*tree.find(30) == "c");
+		REQUIRE(tree.find(15) == nullptr);
+		REQUIRE(tree.lower_bound(11)->key() == 20);
+		REQUIRE(tree.lower_bound(5)->value() == "a");
+		REQUIRE_FALSE(tree.lower_bound(31));
+	}
+	SECTION("given  of every size up to 100 holding even keys")
+	{
+		for (int n = 1; n <= 100; ++n)
+		{
+			std::vector<entry_t> entries{};
+			for (int i = 0; i < n; ++i) entries.push_back(entry_t(2 * i, std::to_string(i)));
+			tree_t tree(entries);
+			for (int k = -1; k <= 2 * n; ++k)
+			{
+				if (k % 2 == 0 && k < 2 * n)
+				{
+					REQUIRE(tree.find(k) != nullptr);
+					REQUIRE(*tree.find(k) == std::to_string(k / 2));
+				}
+				else REQUIRE(tree.find(k) == nullptr);
+				auto lower = tree.lower_bound(k);
+				if (k >= 2 * n - 1) REQUIRE_FALSE(lower);
+				else REQUIRE(lower->key() == (k < 0 ? 0 : k + k % 2));
+			}
+		}
+	}
+}
@@ -0,0 +1,60 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "tree/interval_tree.h"
+
+TEST_CASE("interval_tree answers overlap queries", "[interval_tree]")
+{
+	SECTION("given an empty interval_tree")
+	{
+		data_structures_cpp::interval_tree<int, std::string> tree{};
+		REQUIRE(tree.empty());
+		REQUIRE(tree.overlapping(0, 100).empty());
+		SECTION("inserting reservations [10,20], [15,25], [30,40], [5,8], [35,50], [0,100]")
+		{
+			tree.insert(10, 20, "a");
+			tree.insert(15, 25, "b");
+			tree.insert(30, 40, "c");
+			tree.insert(5, 8, "d");
+			tree.insert(35, 50, "e");
+			tree.insert(0, 100, "f");
+			SECTION("yields size() == 6")
+			{
+				REQUIRE(tree.size() == 6);
+			}
+			SECTION("overlapping(18, 32) yields f, a, b, c in interval order")
+			{
+				auto result = tree.overlapping(18, 32);
+				REQUIRE(result.size() == 4);
+				auto it = result.begin();
+				REQUIRE((*it)->value() == "f");
+				REQUIRE((*++it)->value() == "a");
+				REQUIRE((*++it)->value() == "b");
+				REQUIRE((*++it)->value() == "c");
+			}
+			SECTION("overlapping(8, 8) touches closed endpoints")
+			{
+				auto result = tree.overlapping(8, 8);
+				REQUIRE(result.size() == 2);
+				REQUIRE(result.front()->value() == "f");
+				REQUIRE(result.back()->value() == "d");
+			}
+			SECTION("overlapping(101, 200) yields nothing")
+			{
+				REQUIRE(tree.overlapping(101, 200).empty());
+			}
+			SECTION("erasing [0,100]")
+			{
+				tree.erase(data_structures_cpp::interval<int>{ 0, 100 });
+				SECTION("keeps maximum endpoints coherent")
+				{
+					REQUIRE(tree.overlapping(51, 99).empty());
+					auto result = tree.overlapping(45, 60);
+					REQUIRE(result.size() == 1);
+					REQUIRE(result.front()->value() == "e");
+				}
+			}
+		}
+	}
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch.hpp>
 
 #include <string>
+#include <vector>
 
 #include "tree/linked_binary_tree.h"
 
@@ -65,4 +66,67 @@ TEMPLATE_TEST_CASE("linked_binary_tree's size is coherent", "[linked_binary_tree
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+TEST_CASE("linked_binary_tree traversals visit positions in order", "[linked_binary_tree]")
+{
+	using tree_t = data_structures_cpp::linked_binary_tree<int>;
+	auto collect = [](auto const& traversal) {
+		std::vector<int> values{};
+		for (auto pos : traversal) values.push_back(*pos);
+		return values;
+	};
+	SECTION("given an empty linked_binary_tree")
+	{
+		tree_t tree{};
+		REQUIRE(collect(tree.preorder()).empty());
+		REQUIRE(collect(tree.inorder()).empty());
+		REQUIRE(collect(tree.postorder()).empty());
+		REQUIRE(collect(tree.level_order()).empty());
+	}
+	SECTION("given a linked_binary_tree with root 1, children 2 and 3, grandchildren 4, 5 under 2 and 6, 7 under 5")
+	{
+		tree_t tree{};
+		tree.add_root();
+		auto root = tree.root();
+		*root = 1;
+		tree.expand_external(root);
+		auto left = root.left();
+		*left = 2;
+		*root.right() = 3;
+		tree.expand_external(left);
+		*left.left() = 4;
+		auto leftright = left.right();
+		*leftright = 5;
+		tree.expand_external(leftright);
+		*leftright.left() = 6;
+		*leftright.right() = 7;
+
+		REQUIRE(collect(tree.preorder()) == std::vector<int>{ 1, 2, 4, 5, 6, 7, 3 });
+		REQUIRE(collect(tree.inorder()) == std::vector<int>{ 4, 2, 6, 5, 7, 1, 3 });
+		REQUIRE(collect(tree.postorder()) == std::vector<int>{ 4, 6, 7, 5, 2, 3, 1 });
+		REQUIRE(collect(tree.level_order()) == std::vector<int>{ 1, 2, 3, 4, 5, 6, 7 });
+		REQUIRE(tree.positions().size() == 7);
+	}
+	SECTION("given a linked_binary_tree expanded along a right spine of depth 50")
+	{
+		tree_t tree{};
+		tree.add_root();
+		auto pos = tree.root();
+		*pos = 0;
+		for (int depth = 1; depth <= 50; ++depth)
+		{
+			tree.expand_external(pos);
+			*pos.left() = -depth;
+			pos = pos.right();
+			*pos = depth;
+		}
+		auto level_order = collect(tree.level_order());
+		REQUIRE(level_order.size() == 101);
+		REQUIRE(level_order[1] == -1);
+		REQUIRE(level_order[2] == 1);
+		REQUIRE(level_order.back() == 50);
+		REQUIRE(collect(tree.inorder()).front() == -1);
+		REQUIRE(collect(tree.postorder()).back() == 0);
+	}
+}
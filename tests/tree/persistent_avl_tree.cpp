@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include "tree/persistent_avl_tree.h"
+
+TEST_CASE("persistent_avl_tree snapshots are immutable", "[persistent_avl_tree]")
+{
+	SECTION("given an empty persistent_avl_tree")
+	{
+		data_structures_cpp::persistent_avl_tree<std::string, std::string> tree{};
+		auto empty = tree.snapshot();
+		REQUIRE(tree.empty());
+		REQUIRE(empty.empty());
+		REQUIRE(empty.begin() == empty.end());
+		SECTION("inserting 'i am minh','a vietnamese', 'i am afsa','a persian' and 'i am ahzeen','a persian'")
+		{
+			tree.insert("i am minh", "a vietnamese");
+			tree.insert("i am afsa", "a persian");
+			tree.insert("i am ahzeen", "a persian");
+			auto three = tree.snapshot();
+			SECTION("yields size() == 3 while the earlier snapshot stays empty")
+			{
+				REQUIRE(tree.size() == 3);
+				REQUIRE(three.size() == 3);
+				REQUIRE(empty.size() == 0);
+				REQUIRE(empty.find("i am minh") == empty.end());
+			}
+			SECTION("offers correct accessing methods and ordering")
+			{
+				REQUIRE(three.find("i am ahzeen")->value() == "a persian");
+				REQUIRE(three.height() == 2);
+				auto it = three.begin();
+				REQUIRE(it->key() == "i am afsa");
+				REQUIRE((++it)->key() == "i am ahzeen");
+				REQUIRE((++it)->key() == "i am minh");
+				REQUIRE(++it == three.end());
+			}
+			SECTION("erasing 'i am afsa'")
+			{
+				tree.erase("i am afsa");
+				auto two = tree.snapshot();
+				SECTION("leaves the snapshot taken before intact")
+				{
+					REQUIRE(two.size() == 2);
+					REQUIRE(two.find("i am afsa") == two.end());
+					REQUIRE(three.size() == 3);
+					REQUIRE(three.find("i am afsa")->value() == "a persian");
+				}
+				SECTION("erasing it again throws")
+				{
+					REQUIRE_THROWS(tree.erase("i am afsa"));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("persistent_avl_tree stays balanced and ordered", "[persistent_avl_tree]")
+{
+	data_structures_cpp::persistent_avl_tree<int, int> tree{};
+	for (int k = 0; k < 1000; ++k) tree.insert(k, -k);
+	for (int k = 0; k < 1000; k += 3) tree.erase(k);
+	auto view = tree.snapshot();
+	REQUIRE(view.size() == 666);
+	REQUIRE(view.height() <= 15);
+	int expected = 1, count = 0;
+	for (auto it = view.begin(); it != view.end(); ++it, ++count)
+	{
+		REQUIRE(it->key() == expected);
+		expected += expected % 3 == 1 ? 1 : 2;
+	}
+	REQUIRE(count == 666);
+	auto it = view.find(500);
+	REQUIRE((++it)->key() == 502);
+}
+
+TEST_CASE("persistent_avl_tree snapshots are consistent under a concurrent writer", "[persistent_avl_tree]")
+{
+	data_structures_cpp::persistent_avl_tree<int, int> tree{};
+	std::atomic<bool> done{ false };
+	std::atomic<int> inconsistent{ 0 };
+	std::thread reader([&]() {
+		while (!done)
+		{
+			auto view = tree.snapshot();
+			std::size_t count = 0;
+			int previous = -1;
+			for (auto it = view.begin(); it != view.end(); ++it, ++count)
+			{
+				if (it->key() <= previous) ++inconsistent;
+				previous = it->key();
+			}
+			if (count != view.size()) ++inconsistent;
+		}
+	});
+	for (int k = 0; k < 2000; ++k) tree.insert(k, k);
+	for (int k = 0; k < 2000; k += 2) tree.erase(k);
+	done = true;
+	reader.join();
+	REQUIRE(inconsistent == 0);
+	REQUIRE(tree.size() == 1000);
+}
@@ -186,12 +186,13 @@ TEST_CASE("vector_binary_tree respects binary tree rules", "[vector_binary_tree]
 					}
 					SECTION("removing above external node left-left")
 					{
-						tree.remove_above_external(leftleft);
-						SECTION("preserves preorder ordering")
+						auto moved = tree.remove_above_external(leftleft);
+						SECTION("moves left-right up in place of left and preserves preorder ordering")
 						{
+							REQUIRE(*moved == "i am right child of left child");
 							std::list<data_structures_cpp::vector_binary_tree_position<std::string>> list{};
 							list.push_back(root);
-							list.push_back(leftright);
+							list.push_back(moved);
 							list.push_back(right);
 							list.push_back(rightleft);
 							list.push_back(rightright);
@@ -204,36 +205,37 @@ TEST_CASE("vector_binary_tree respects binary tree rules", "[vector_binary_tree]
 					}
 					SECTION("removing above external node right-right")
 					{
-						tree.remove_above_external(rightright);
-						SECTION("preserves preorder ordering")
+						auto moved = tree.remove_above_external(rightright);
+						SECTION("moves right-left up in place of right and preserves preorder ordering")
 						{
+							REQUIRE(*moved == "i am left child of right child");
 							std::list<data_structures_cpp::vector_binary_tree_position<std::string>> list{};
 							list.push_back(root);
 							list.push_back(left);
 							list.push_back(leftleft);
 							list.push_back(leftright);
-							list.push_back(rightleft);
+							list.push_back(moved);
 							auto positions = tree.positions();
 							for (auto it = list.cbegin(), pos = positions.cbegin(); it != list.cend(); ++it, ++pos)
 							{
 								REQUIRE(*(*it) == *(*pos));
 							}
 						}
-						SECTION("then removing above right")
+						SECTION("then removing above the moved up leaf")
 						{
-							tree.remove_above_external(right);
-							SECTION("preserves preorder ordering")
+							auto top = tree.remove_above_external(moved);
+							SECTION("moves the left subtree up to the root and preserves preorder ordering")
 							{
-								std::list<data_structures_cpp::vector_binary_tree_position<std::string>> list{};
-								list.push_back(left);
-								list.push_back(leftleft);
-								list.push_back(leftright);
+								REQUIRE(tree.size() == 3);
+								REQUIRE(top.root());
+								REQUIRE(*top == "i am left child");
+								REQUIRE(*top.left() == "i am left child of left child");
+								REQUIRE(*top.right() == "i am right child of left child");
+								std::list<std::string> list{ "i am left child", "i am left child of left child", "i am right child of left child" };
 								auto positions = tree.positions();
 								REQUIRE(positions.size() == list.size());
-								for (auto it = list.cbegin(), pos = positions.cbegin(); it != list.cend(); ++it, ++pos)
-								{
-									REQUIRE(*(*it) == *(*pos));
-								}
+								auto pos = positions.cbegin();
+								for (auto const& value : list) REQUIRE(value == *(*pos++));
 							}
 						}
 					}
@@ -241,4 +243,58 @@ TEST_CASE("vector_binary_tree respects binary tree rules", "[vector_binary_tree]
 			}
 		}
 	}
-}
\ No newline at end of file
+}
+
+TEMPLATE_TEST_CASE("vector_binary_tree storages never grow on queries", "[vector_binary_tree]",
+	data_structures_cpp::dense_node_storage<int>, data_structures_cpp::sparse_node_storage<int>)
+{
+	SECTION("given a vector_binary_tree with a root and two children")
+	{
+		data_structures_cpp::vector_binary_tree<int, TestType> tree{};
+		tree.add_root();
+		auto root = tree.root();
+		tree.expand_external(root);
+		std::size_t slots = tree.storage().slots();
+		SECTION("querying external() on every node keeps the storage untouched")
+		{
+			REQUIRE_FALSE(root.external());
+			REQUIRE(root.left().external());
+			REQUIRE(root.right().external());
+			REQUIRE(tree.storage().slots() == slots);
+		}
+		SECTION("removing above a leaf whose sibling has children moves the sibling subtree up")
+		{
+			auto right = root.right();
+			tree.expand_external(right);
+			*right = 3;
+			*right.left() = 6;
+			*right.right() = 7;
+			auto moved = tree.remove_above_external(root.left());
+			REQUIRE(tree.size() == 3);
+			REQUIRE(moved.root());
+			REQUIRE(*moved == 3);
+			REQUIRE(*moved.left() == 6);
+			REQUIRE(*moved.right() == 7);
+			REQUIRE(moved.left().external());
+			REQUIRE(tree.positions().size() == 3);
+		}
+	}
+}
+
+TEST_CASE("vector_binary_tree with sparse_node_storage uses memory linear in its size", "[vector_binary_tree]")
+{
+	SECTION("given a degenerate chain of 40 internal nodes")
+	{
+		data_structures_cpp::vector_binary_tree<int, data_structures_cpp::sparse_node_storage<int>> tree{};
+		tree.add_root();
+		auto pos = tree.root();
+		for (int depth = 0; depth < 40; ++depth)
+		{
+			tree.expand_external(pos);
+			pos = pos.right();
+		}
+		REQUIRE(tree.size() == 81);
+		REQUIRE(tree.storage().slots() == 81);
+		REQUIRE(tree.positions().size() == 81);
+	}
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+
+#include <set>
+#include <bitset>
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#include "utils/hash.h"
+
+TEST_CASE("default_hash spreads integers over every bit", "[hash]")
+{
+	data_structures_cpp::default_hash<std::uint64_t> hash{};
+	SECTION("flipping one input bit flips about half of the output bits")
+	{
+		int flipped = 0, trials = 0;
+		for (std::uint64_t x = 0; x < 64; ++x)
+		{
+			for (int bit = 0; bit < 64; ++bit, ++trials)
+			{
+				flipped += static_cast<int>(std::bitset<64>(hash(x) ^ hash(x ^ (std::uint64_t(1) << bit))).count());
+			}
+		}
+		double mean = static_cast<double>(flipped) / trials;
+		REQUIRE(mean > 30);
+		REQUIRE(mean < 34);
+	}
+	SECTION("sequential keys differ in their low bits")
+	{
+		std::set<std::uint64_t> low_bits{};
+		for (std::uint64_t x = 0; x < 1024; ++x) low_bits.insert(hash(x << 32) & 0xffff);
+		REQUIRE(low_bits.size() > 1000);
+	}
+}
+
+TEST_CASE("default_hash of strings is transparent and length aware", "[hash]")
+{
+	data_structures_cpp::default_hash<std::string> hash{};
+	SECTION("strings, views and literals of the same characters hash alike")
+	{
+		std::string s = "a reasonably long key spanning several words";
+		REQUIRE(hash(s) == hash(std::string_view(s)));
+		REQUIRE(hash(s) == hash("a reasonably long key spanning several words"));
+	}
+	SECTION("every prefix of a string hashes differently")
+	{
+		std::string s(100, 'x');
+		std::set<std::size_t> hashes{};
+		for (std::size_t n = 0; n <= s.size(); ++n) hashes.insert(hash(std::string_view(s.data(), n)));
+		REQUIRE(hashes.size() == s.size() + 1);
+	}
+	SECTION("strings differing in one character hash differently")
+	{
+		std::set<std::size_t> hashes{};
+		for (int i = 0; i < 40; ++i)
+		{
+			std::string s(40, 'a');
+			s[i] = 'b';
+			hashes.insert(hash(s));
+		}
+		REQUIRE(hashes.size() == 40);
+	}
+}
\ No newline at end of file